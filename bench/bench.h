@@ -0,0 +1,56 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_BENCH_H
+#define WIN32_BENCH_H
+
+// Timing and reporting helpers shared by the Win32 benchmarks
+
+#include "vala-win32.h"
+
+/* UTILITY
+------------------------------------------- */
+// Milliseconds since the performance counter was read into start
+static inline double elapsed_ms (LARGE_INTEGER *start)
+{
+    LARGE_INTEGER frequency, end;
+    QueryPerformanceFrequency (&frequency);
+    QueryPerformanceCounter (&end);
+    return (double) (end.QuadPart - start->QuadPart) * 1e3 / frequency.QuadPart;
+}
+
+
+/* UTILITY
+------------------------------------------- */
+// A counter line, indented under the title of the measurement
+static inline void print_counter (const char *name, gulong value)
+{
+    printf ("    %-20s %10lu\n", name, value);
+}
+
+static inline void print_call_count (Win32CallType call)
+{
+    print_counter (win32_statistics_get_call_name (call), win32_statistics_get_call_count (call));
+}
+
+static inline void print_cache_count (Win32CacheCounter counter)
+{
+    print_counter (win32_statistics_get_cache_name (counter), win32_statistics_get_cache_count (counter));
+}
+
+
+/* UTILITY
+------------------------------------------- */
+// The USER32 calls made since the statistics were reset
+static inline void print_calls (const char *title, double elapsed)
+{
+    printf ("%s: %.2f ms, %lu USER32 calls\n", title, elapsed, win32_statistics_get_total_calls ());
+    for (int call=0; call<WIN32_NUM_CALLS; call++){
+        if ( win32_statistics_get_call_count (call) == 0 ) continue;
+        print_call_count (call);
+    }
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+#define NUM_MESSAGES 1000000
+
+static unsigned long numCalls = 0;
+
+static void on_event (Win32Event *event, void *boundData)
+{
+    numCalls += 1;
+}
+
+
+/* BASELINE
+------------------------------------------- */
+// The dispatch loop as it was before the events were hashed: a linear scan
+// of the event list for every message
+static LRESULT linear_dispatch (HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    Win32Window *window = (Win32Window *) GetWindowLongPtr( hwnd, GWLP_USERDATA);
+    Win32EventListItem *events = window->attachedEvents.items;
+    LRESULT result = 0;
+
+    for (size_t i=0; i<window->attachedEvents.length; i++){
+        if ( events[i].eventID == msg){
+            for (size_t n=0; n<events[i].numListeners; n++){
+                Win32Event event = { msg, window, wParam, lParam, 0 };
+                events[i].listeners[n].callback ( &event, events[i].listeners[n].boundData );
+                if ( event.handled == 1 ) result = STOP_PROPAGATION;
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+
+/* BENCHMARK
+------------------------------------------- */
+static double measure (LRESULT (*procedure) (HWND, UINT, WPARAM, LPARAM), HWND hwnd, const UINT *messages, size_t numMessages)
+{
+    LARGE_INTEGER frequency, start, end;
+    QueryPerformanceFrequency (&frequency);
+    QueryPerformanceCounter (&start);
+
+    for (size_t i=0; i<NUM_MESSAGES; i++) procedure (hwnd, messages[i % numMessages], 0, 0);
+
+    QueryPerformanceCounter (&end);
+    return (double) (end.QuadPart - start.QuadPart) * 1e3 / frequency.QuadPart;
+}
+
+
+int main (int argc, char **argv)
+{
+    // Listeners a typical application window ends up with
+    UINT listened[] = { WM_COMMAND, WM_SIZE, WM_CLOSE, WM_KEYDOWN, WM_CHAR, WM_LBUTTONDOWN, WM_LBUTTONUP,
+                        WM_RBUTTONDOWN, WM_TIMER, WM_NOTIFY, WM_CTLCOLORSTATIC, WM_SETFOCUS };
+    // The bulk of the traffic has no listeners at all
+    UINT messages[] = { WM_MOUSEMOVE, WM_NCHITTEST, WM_SETCURSOR, WM_MOUSEMOVE, WM_NCHITTEST, WM_SETCURSOR,
+                        WM_PAINT, WM_NCMOUSEMOVE, WM_GETICON, WM_ERASEBKGND, WM_MOUSEMOVE, WM_NCHITTEST,
+                        WM_SETCURSOR, WM_TIMER, WM_LBUTTONDOWN, WM_LBUTTONUP };
+
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    win32_application_window_create (appWindow);
+    HWND hwnd = ((Win32Window*) appWindow)->hwnd;
+
+    for (int i=0; i<G_N_ELEMENTS(listened); i++){
+        win32_window_add_listener ((Win32Window*) appWindow, listened[i], on_event, NULL, NULL, LISTENER_NONE);
+    }
+
+    double linear = measure (linear_dispatch, hwnd, messages, G_N_ELEMENTS(messages));
+    unsigned long linearCalls = numCalls;
+    numCalls = 0;
+    double hashed = measure (win32_window_default_procedure, hwnd, messages, G_N_ELEMENTS(messages));
+
+    printf ("%d messages, %d events with listeners\n", NUM_MESSAGES, (int) G_N_ELEMENTS(listened));
+    printf ("%16s %12s %12s\n", "", "time (ms)", "callbacks");
+    printf ("%16s %12.2f %12lu\n", "linear scan", linear, linearCalls);
+    printf ("%16s %12.2f %12lu\n", "hashed", hashed, numCalls);
+
+    win32_window_unref (appWindow);
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define NUM_CONTROLS  100
+#define NUM_READS     1000
+
+/* BENCHMARK Geometry properties
+------------------------------------------- */
+// Reading the geometry of a control used to cost a GetClientRect and a
+// MapWindowPoints call per property, setting it another round trip on top.
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    win32_application_window_create (appWindow);
+
+    Win32Window *controls[NUM_CONTROLS];
+    for (int i=0; i<NUM_CONTROLS; i++){
+        controls[i] = (Win32Window*) win32_button_new ((Win32Window*) appWindow, "Button");
+    }
+
+    LARGE_INTEGER start;
+    long sum = 0;
+
+    win32_statistics_reset ();
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_READS; n++){
+        for (int i=0; i<NUM_CONTROLS; i++){
+            sum += win32_window_get_left (controls[i]) + win32_window_get_top (controls[i]) +
+                   win32_window_get_width (controls[i]) + win32_window_get_height (controls[i]);
+        }
+    }
+    printf ("%d reads of left, top, width and height of %d controls\n", NUM_READS, NUM_CONTROLS);
+    print_calls ("reads", elapsed_ms (&start));
+
+    win32_statistics_reset ();
+    QueryPerformanceCounter (&start);
+    for (int i=0; i<NUM_CONTROLS; i++){
+        win32_window_set_left (controls[i], i);
+        win32_window_set_top (controls[i], i * 2);
+        win32_window_set_width (controls[i], 80);
+        win32_window_set_height (controls[i], 24);
+    }
+    print_calls ("writes", elapsed_ms (&start));
+
+    // The same writes batched into a single update of the application window
+    win32_statistics_reset ();
+    QueryPerformanceCounter (&start);
+    win32_window_begin_update ((Win32Window*) appWindow);
+    for (int i=0; i<NUM_CONTROLS; i++){
+        win32_window_set_left (controls[i], i + 1);
+        win32_window_set_top (controls[i], i * 2 + 1);
+        win32_window_set_width (controls[i], 90);
+        win32_window_set_height (controls[i], 26);
+    }
+    win32_window_end_update ((Win32Window*) appWindow);
+    print_calls ("batched writes", elapsed_ms (&start));
+
+    // Rect queries fill storage on the stack and don't allocate
+    RECT rect;
+    win32_statistics_reset ();
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_READS; n++){
+        for (int i=0; i<NUM_CONTROLS; i++){
+            win32_window_get_client_rect (controls[i], &rect);
+            sum += rect.right;
+        }
+    }
+    print_calls ("client rect reads", elapsed_ms (&start));
+
+    for (int i=0; i<NUM_CONTROLS; i++) win32_window_unref (controls[i]);
+    win32_window_unref (appWindow);
+
+    return sum == 0;
+}
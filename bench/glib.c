@@ -0,0 +1,120 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define NUM_CALLS      500
+#define POLL_INTERVAL  10    // ms, the timer of the polling loop
+
+static HANDLE g_ack = NULL;           // set by the UI thread once a call has run
+static LARGE_INTEGER g_invoked;
+static double g_totalLatency = 0;
+static double g_worstLatency = 0;
+static int g_handled = 0;
+static gulong g_wakeups = 0;
+
+// Time the thread spent on the CPU, in ms
+static double cpu_ms (void)
+{
+    FILETIME creation, exit, kernel, user;
+    GetThreadTimes (GetCurrentThread (), &creation, &exit, &kernel, &user);
+    guint64 k = ((guint64) kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+    guint64 u = ((guint64) user.dwHighDateTime << 32) | user.dwLowDateTime;
+    return (double) (k + u) / 1e4;   // 100 ns units
+}
+
+// Runs on the thread iterating the default context, like an async callback would
+static gboolean on_invoke (gpointer data)
+{
+    double latency = elapsed_ms (&g_invoked);
+    g_totalLatency += latency;
+    if ( latency > g_worstLatency ) g_worstLatency = latency;
+    g_handled += 1;
+    if ( g_handled == NUM_CALLS ) PostQuitMessage (0);
+    SetEvent (g_ack);
+    return G_SOURCE_REMOVE;
+}
+
+// Queues calls onto the default context one at a time, as completing I/O does
+static gpointer invoke_worker (gpointer data)
+{
+    for (int n=0; n<NUM_CALLS; n++){
+        Sleep (2);
+        QueryPerformanceCounter (&g_invoked);
+        g_main_context_invoke (NULL, on_invoke, NULL);
+        WaitForSingleObject (g_ack, INFINITE);
+    }
+    return NULL;
+}
+
+static void run (const char *title, void (*loop) (void))
+{
+    LARGE_INTEGER start;
+    g_totalLatency = 0;
+    g_worstLatency = 0;
+    g_handled = 0;
+    g_wakeups = 0;
+
+    double cpuStart = cpu_ms ();
+    QueryPerformanceCounter (&start);
+    GThread *worker = g_thread_new (NULL, invoke_worker, NULL);
+    loop ();
+    g_thread_join (worker);
+
+    printf ("%s: %.2f ms\n", title, elapsed_ms (&start));
+    printf ("    %-20s %10.3f ms\n", "average latency", g_totalLatency / g_handled);
+    printf ("    %-20s %10.3f ms\n", "worst latency", g_worstLatency);
+    printf ("    %-20s %10.3f ms\n", "UI thread CPU", cpu_ms () - cpuStart);
+    if ( g_wakeups > 0 ) print_counter ("timer wake-ups", g_wakeups);
+}
+
+
+/* BASELINE Timer polling
+------------------------------------------- */
+// The context is iterated on a timer, the hack without a bridge
+static void poll_context (void)
+{
+    MSG msg;
+    UINT_PTR timer = SetTimer (NULL, 0, POLL_INTERVAL, NULL);
+    while ( GetMessage (&msg, NULL, 0, 0) > 0 ){
+        if ( msg.message == WM_TIMER ){
+            g_wakeups += 1;
+            while ( g_main_context_iteration (NULL, FALSE) );
+            continue;
+        }
+        TranslateMessage (&msg);
+        DispatchMessage (&msg);
+    }
+    KillTimer (NULL, timer);
+}
+
+
+/* BENCHMARK Main loop bridge
+------------------------------------------- */
+static void run_main_loop (void)
+{
+    Win32MainLoop *loop = win32_main_loop_new ();
+    win32_main_loop_run (loop);
+    win32_main_loop_unref (loop);
+}
+
+
+// A worker completes work onto the default GLib context, the UI thread runs
+// the callbacks while pumping its messages
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    win32_application_window_create (appWindow);
+    g_ack = CreateEvent (NULL, FALSE, FALSE, NULL);
+
+    printf ("%d calls onto the default context\n", NUM_CALLS);
+    run ("Timer polling", poll_context);
+    run ("Win32MainLoop", run_main_loop);
+
+    CloseHandle (g_ack);
+    win32_window_unref (appWindow);
+
+    return 0;
+}
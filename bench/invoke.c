@@ -0,0 +1,94 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define NUM_THREADS  4
+#define NUM_UPDATES  100000   // per thread
+
+#define WM_UPDATE  (WM_APP + 1)
+
+static Win32Window *g_label = NULL;
+static volatile int g_finished = 0;
+static gulong g_applied = 0;
+static gulong g_messages = 0;
+
+static void apply_update (Win32Window *window, void *boundData)
+{
+    if ( boundData != NULL ) g_applied += 1;
+}
+
+
+/* BASELINE PostMessage
+------------------------------------------- */
+// One message per update, the payload travels in lParam
+static gpointer post_updates (gpointer data)
+{
+    for (int n=1; n<=NUM_UPDATES; n++){
+        while ( !PostMessage (g_label->hwnd, WM_UPDATE, 0, n) ) Sleep (0);  // the queue holds 10000 messages
+    }
+    g_atomic_int_inc (&g_finished);
+    return NULL;
+}
+
+
+/* BENCHMARK Invoke queue
+------------------------------------------- */
+static gpointer invoke_updates (gpointer data)
+{
+    for (int n=1; n<=NUM_UPDATES; n++){
+        win32_window_invoke_async (g_label, apply_update, (void*) (gintptr) n, NULL);
+    }
+    g_atomic_int_inc (&g_finished);
+    return NULL;
+}
+
+static void run (const char *title, GThreadFunc producer)
+{
+    LARGE_INTEGER start;
+    GThread *threads[NUM_THREADS];
+
+    g_finished = 0;
+    g_applied = 0;
+    g_messages = 0;
+
+    QueryPerformanceCounter (&start);
+    for (int i=0; i<NUM_THREADS; i++) threads[i] = g_thread_new (NULL, producer, NULL);
+
+    while ( g_applied < NUM_THREADS * NUM_UPDATES ){
+        MSG msg;
+        if ( !GetMessage (&msg, NULL, 0, 0) ) break;
+        g_messages += 1;
+        if ( msg.message == WM_UPDATE ){
+            apply_update (g_label, (void*) msg.lParam);
+            continue;
+        }
+        DispatchMessage (&msg);
+    }
+    double elapsed = elapsed_ms (&start);
+    for (int i=0; i<NUM_THREADS; i++) g_thread_join (threads[i]);
+
+    printf ("%s: %.2f ms, %.0f updates/s\n", title, elapsed, NUM_THREADS * NUM_UPDATES / elapsed * 1e3);
+    print_counter ("messages", g_messages);
+}
+
+
+// Threads push updates into a label as fast as they can, the UI thread
+// applies them. The updates are trivial, what's measured is getting them there.
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    g_label = (Win32Window*) win32_label_new ((Win32Window*) appWindow, "0");
+    win32_application_window_create (appWindow);
+
+    printf ("%d threads, %d updates each\n", NUM_THREADS, NUM_UPDATES);
+    run ("PostMessage per update", post_updates);
+    run ("invoke_async", invoke_updates);
+
+    win32_window_unref (g_label);
+    win32_window_unref (appWindow);
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define NUM_UPDATES  10000
+
+static const char *states[] = { "Idle", "Reading.", "Reading..", "Reading...", "Encrypting", "Writing", "Done" };
+
+static void print_counters (const char *title, double elapsed)
+{
+    printf ("%s: %.2f ms\n", title, elapsed);
+    print_call_count (WIN32_CALL_GET_TEXT_EXTENT);
+    print_cache_count (WIN32_CACHE_TEXT_EXTENT_HIT);
+    print_cache_count (WIN32_CACHE_TEXT_EXTENT_MISS);
+}
+
+
+/* BENCHMARK Label updates
+------------------------------------------- */
+// A status label cycling through a few states and a progress label showing a
+// new number on every update. Labels used to acquire a window DC for each
+// measurement, the first run repeats that on the same texts.
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    Win32Window *status   = (Win32Window*) win32_label_new ((Win32Window*) appWindow, "Idle");
+    Win32Window *progress = (Win32Window*) win32_label_new ((Win32Window*) appWindow, "0");
+    win32_application_window_create (appWindow);
+
+    LARGE_INTEGER start;
+    wchar_t wideText[32];
+    char text[32];
+    SIZE size;
+    long sum = 0;
+
+    // A label gets its first size from its text in the default GUI font
+    win32_text_metrics_measure (win32_get_default_gui_font (), L"Idle", 4, &size);
+    if ( status->width != size.cx || status->height != size.cy ){
+        printf ("created label is %dx%d, its text measures %ldx%ld\n", status->width, status->height, size.cx, size.cy);
+        return 1;
+    }
+
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_UPDATES; n++){
+        HDC context = GetDC (status->hwnd);
+        int length = MultiByteToWideChar (CP_UTF8, 0, states[n % G_N_ELEMENTS(states)], -1, wideText, 32) - 1;
+        GetTextExtentPoint32 (context, wideText, length, &size);
+        ReleaseDC (status->hwnd, context);
+        sum += size.cx;
+
+        context = GetDC (progress->hwnd);
+        length = swprintf (wideText, 32, L"%d files", n);
+        GetTextExtentPoint32 (context, wideText, length, &size);
+        ReleaseDC (progress->hwnd, context);
+        sum += size.cx;
+    }
+    printf ("%d updates of two labels\n", NUM_UPDATES);
+    printf ("window DC measurement: %.2f ms\n", elapsed_ms (&start));
+
+    win32_statistics_reset ();
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_UPDATES; n++){
+        MultiByteToWideChar (CP_UTF8, 0, states[n % G_N_ELEMENTS(states)], -1, wideText, 32);
+        win32_text_metrics_measure_window (status, wideText, &size);
+        sum += size.cx;
+
+        swprintf (wideText, 32, L"%d files", n);
+        win32_text_metrics_measure_window (progress, wideText, &size);
+        sum += size.cx;
+    }
+    print_counters ("cached measurement", elapsed_ms (&start));
+
+    win32_statistics_reset ();
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_UPDATES; n++){
+        win32_window_set_text (status, states[n % G_N_ELEMENTS(states)]);
+        snprintf (text, sizeof(text), "%d files", n);
+        win32_window_set_text (progress, text);
+        sum += status->width + progress->width;
+    }
+    print_counters ("set_text with auto resize", elapsed_ms (&start));
+
+    win32_window_unref (status);
+    win32_window_unref (progress);
+    win32_window_unref (appWindow);
+
+    return sum == 0;
+}
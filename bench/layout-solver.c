@@ -0,0 +1,228 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+// Headless benchmark of the layout solver. It does not need the Windows or GLib
+// headers, build it with the host compiler: make bench-native
+//
+//   build/bin/bench-layout-solver          timings
+//   build/bin/bench-layout-solver --fuzz   compares incremental passes against full ones
+
+#include "layout-solver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define REPETITIONS      20
+#define FUZZ_ITERATIONS  2000
+
+static const Win32LayoutMetrics metrics = { 8, 8, 5, 5, 100 };
+
+/* UTILITY
+------------------------------------------- */
+static double now (void)
+{
+    struct timespec ts;
+    timespec_get (&ts, TIME_UTC);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+
+/* UTILITY
+------------------------------------------- */
+// Same arrangement as the Win32 benchmark: every item is anchored to the next
+// one so the planner has to resolve a dependency chain as long as the item list.
+static void build_chain (Win32LayoutSolver *solver, size_t numItems)
+{
+    Win32LayoutItem *items = win32_layout_solver_set_size (solver, numItems);
+
+    for (size_t i=0; i<numItems; i++)
+    {
+        memset( &items[i], 0, sizeof(Win32LayoutItem) );
+        items[i].width  = 100;
+        items[i].height = 20;
+        if ( i + 1 == numItems ) continue;
+
+        items[i].anchors[1] = (Win32LayoutAnchorSpec) { LAYOUT_ANCHOR_SIBLING, i + 1, EDGE_BOTTOM, 0, 1 };
+        items[i].anchors[0] = (Win32LayoutAnchorSpec) { LAYOUT_ANCHOR_PARENT, 0, 0, 0, 1 };
+        if ( i % 3 == 0 )
+            items[i].anchors[2] = (Win32LayoutAnchorSpec) { LAYOUT_ANCHOR_SIBLING, i + 1, EDGE_LEFT, 0, 1 };
+    }
+}
+
+
+/* BENCHMARK
+------------------------------------------- */
+static void measure (size_t numItems)
+{
+    Win32LayoutSolver solver;
+    Win32LayoutRecorder recorder;
+    double start, plan, full, incremental;
+
+    win32_layout_solver_init (&solver);
+    win32_layout_recorder_init (&recorder);
+    build_chain (&solver, numItems);
+
+    start = now ();
+    for (int n=0; n<REPETITIONS; n++) win32_layout_solver_plan (&solver);
+    plan = (now () - start) / REPETITIONS;
+
+    start = now ();
+    for (int n=0; n<REPETITIONS; n++){
+        solver.fullPass = 1;
+        win32_layout_solver_solve (&solver, &metrics, 800, 600, &recorder.sink);
+    }
+    full = (now () - start) / REPETITIONS;
+
+    // A single item in the middle of the chain changes its size
+    start = now ();
+    for (int n=0; n<REPETITIONS; n++){
+        solver.items[numItems / 2].width += 1;
+        solver.items[numItems / 2].dirty = EDGE_ALL;
+        win32_layout_solver_solve (&solver, &metrics, 800, 600, &recorder.sink);
+    }
+    incremental = (now () - start) / REPETITIONS;
+
+    printf ("%8zu items: plan %10.1f us, full solve %10.1f us, incremental solve %10.1f us\n",
+            numItems, plan, full, incremental);
+
+    win32_layout_recorder_clear (&recorder);
+    win32_layout_solver_clear (&solver);
+}
+
+
+/* FUZZ UTILITY
+------------------------------------------- */
+static void random_anchor (Win32LayoutAnchorSpec *anchor, size_t numItems)
+{
+    static const int edges[] = { EDGE_LEFT, EDGE_TOP, EDGE_RIGHT, EDGE_BOTTOM };
+
+    anchor->kind    = rand () % 3;
+    anchor->sibling = rand () % numItems;
+    anchor->edge    = edges[rand () % 4];
+    anchor->ratio   = rand () % 101;
+    anchor->dirty   = 1;
+}
+
+
+/* FUZZ UTILITY
+------------------------------------------- */
+// Every planned edge must come after the edge it is calculated from
+static int check_order (Win32LayoutSolver *solver, size_t *position)
+{
+    size_t numNodes = solver->numItems * 4;
+
+    for (size_t node=0; node<numNodes; node++) position[node] = EDGE_NO_DEPENDENCY;
+    for (size_t i=0; i<solver->orderLength; i++){
+        if ( position[solver->order[i]] != EDGE_NO_DEPENDENCY ) return 0;
+        position[solver->order[i]] = i;
+    }
+    for (size_t i=0; i<solver->orderLength; i++){
+        size_t dependency = solver->dependency[solver->order[i]];
+        if ( dependency != EDGE_NO_DEPENDENCY && position[dependency] >= i ) return 0;
+    }
+    return 1;
+}
+
+
+/* FUZZ
+------------------------------------------- */
+// Random anchors, cycles included, are solved incrementally after random
+// changes and compared with a fresh solver doing a full pass.
+static int fuzz (int iterations)
+{
+    Win32LayoutSolver incremental, reference;
+    Win32LayoutRecorder recorder;
+    int failures = 0;
+
+    win32_layout_solver_init (&incremental);
+    win32_layout_recorder_init (&recorder);
+
+    for (int iteration=0; iteration<iterations; iteration++)
+    {
+        size_t numItems = 1 + rand () % 64;
+        Win32LayoutItem *items = win32_layout_solver_set_size (&incremental, numItems);
+
+        for (size_t i=0; i<numItems; i++){
+            memset( &items[i], 0, sizeof(Win32LayoutItem) );
+            for (int n=0; n<4; n++) random_anchor (&items[i].anchors[n], numItems);
+            items[i].width  = rand () % 200;
+            items[i].height = rand () % 50;
+        }
+        win32_layout_solver_plan (&incremental);
+
+        size_t *position = malloc( sizeof(size_t) * numItems * 4 );
+        if ( !check_order (&incremental, position) ){
+            printf ("iteration %d: edges out of order\n", iteration);
+            failures += 1;
+        }
+
+        int clientWidth = 800, clientHeight = 600;
+        win32_layout_solver_solve (&incremental, &metrics, clientWidth, clientHeight, &recorder.sink);
+
+        for (int pass=0; pass<8; pass++)
+        {
+            // Change some sizes, ratios and occasionally the size of the container
+            for (int change=rand () % 4; change>=0; change--){
+                Win32LayoutItem *item = &incremental.items[rand () % numItems];
+                int n = rand () % 4;
+                if ( rand () % 2 ){
+                    item->width  = rand () % 200;
+                    item->height = rand () % 50;
+                    item->dirty  = EDGE_ALL;
+                } else if ( item->anchors[n].kind == LAYOUT_ANCHOR_PARENT ){
+                    item->anchors[n].ratio = rand () % 101;
+                    item->anchors[n].dirty = 1;
+                }
+            }
+            if ( rand () % 4 == 0 ) clientWidth = 400 + rand () % 800;
+
+            win32_layout_solver_solve (&incremental, &metrics, clientWidth, clientHeight, &recorder.sink);
+
+            win32_layout_solver_init (&reference);
+            memcpy( win32_layout_solver_set_size (&reference, numItems), incremental.items,
+                    sizeof(Win32LayoutItem) * numItems );
+            for (size_t i=0; i<numItems; i++) memset( reference.items[i].edges, 0, sizeof(int[4]) );
+            win32_layout_solver_plan (&reference);
+            win32_layout_solver_solve (&reference, &metrics, clientWidth, clientHeight, &recorder.sink);
+
+            // Edges left out of the plan keep their previous values, only the planned ones are compared
+            for (size_t i=0; i<incremental.orderLength; i++){
+                size_t node = incremental.order[i];
+                if ( incremental.items[node / 4].edges[node % 4] != reference.items[node / 4].edges[node % 4] ){
+                    printf ("iteration %d, pass %d: edge %zu differs\n", iteration, pass, node);
+                    failures += 1;
+                    break;
+                }
+            }
+            win32_layout_solver_clear (&reference);
+        }
+        free (position);
+    }
+
+    win32_layout_recorder_clear (&recorder);
+    win32_layout_solver_clear (&incremental);
+
+    printf ("%d iterations, %d failures\n", iterations, failures);
+    return failures == 0 ? 0 : 1;
+}
+
+
+int main (int argc, char *argv[])
+{
+    if ( argc > 1 && strcmp (argv[1], "--fuzz") == 0 ){
+        srand (argc > 2 ? atoi (argv[2]) : 1);
+        return fuzz (FUZZ_ITERATIONS);
+    }
+
+    printf ("LayoutSolver, average of %d runs\n", REPETITIONS);
+    measure (10);
+    measure (100);
+    measure (1000);
+    measure (10000);
+    measure (100000);
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+#define REPETITIONS 20
+
+/* BENCHMARK RelativeLayout configure
+------------------------------------------- */
+// Every child is anchored to the next one so the planner has to resolve a
+// dependency chain as long as the child list itself.
+static double measure_configure (size_t numChildren)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    Win32Container *container = (Win32Container*) appWindow;
+    Win32RelativeLayout *layout = win32_relative_layout_new (8, 5);
+    win32_container_set_layout (container, (Win32Layout*) layout);
+
+    Win32Label **labels = malloc( sizeof(Win32Label*) * numChildren );
+    for (size_t i=0; i<numChildren; i++){
+        labels[i] = win32_label_new ((Win32Window*) appWindow, "Label");
+    }
+
+    Win32Anchor *anchor;
+    for (size_t i=0; i+1<numChildren; i++)
+    {
+        Win32LayoutData *positioning = ((Win32Window*) labels[i])->positioning;
+
+        anchor = win32_anchor_to_sibling ((Win32Window*) labels[i+1], 0);
+        win32_layout_data_set_top (positioning, anchor);
+        win32_anchor_unref (anchor);
+
+        anchor = win32_anchor_to_parent (0, 0);
+        win32_layout_data_set_left (positioning, anchor);
+        win32_anchor_unref (anchor);
+
+        if ( i % 3 == 0 ){
+            anchor = win32_anchor_to_sibling ((Win32Window*) labels[i+1], 0);
+            win32_layout_data_set_right (positioning, anchor);
+            win32_anchor_unref (anchor);
+        }
+    }
+
+    LARGE_INTEGER frequency, start, end;
+    QueryPerformanceFrequency (&frequency);
+    QueryPerformanceCounter (&start);
+
+    for (int n=0; n<REPETITIONS; n++) container->layout->configure (container);
+
+    QueryPerformanceCounter (&end);
+
+    for (size_t i=0; i<numChildren; i++) win32_window_unref (labels[i]);
+    free (labels);
+    win32_layout_unref (layout);
+    win32_window_unref (appWindow);
+
+    return (double) (end.QuadPart - start.QuadPart) * 1e6 / frequency.QuadPart / REPETITIONS;
+}
+
+
+int main (int argc, char **argv)
+{
+    size_t sizes[] = { 10, 100, 1000, 10000 };
+
+    printf ("%10s %16s\n", "children", "configure (us)");
+    for (int i=0; i<G_N_ELEMENTS(sizes); i++){
+        printf ("%10u %16.2f\n", (unsigned) sizes[i], measure_configure (sizes[i]));
+    }
+    return 0;
+}
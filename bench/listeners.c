@@ -0,0 +1,55 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+#define REPETITIONS 20
+
+static void on_event (Win32Event *event, void *boundData)
+{
+    // NO-OP
+}
+
+
+/* BENCHMARK Listener registration
+------------------------------------------- */
+// Registers the listeners either on a single event or spread over as many
+// distinct events, returns the average cost of a registration in nanoseconds
+static double measure_registration (size_t numListeners, BOOL distinctEvents)
+{
+    LARGE_INTEGER frequency, start, end;
+    LONGLONG elapsed = 0;
+    QueryPerformanceFrequency (&frequency);
+
+    for (int n=0; n<REPETITIONS; n++)
+    {
+        // The window is never created, its listeners are released on finalization
+        Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+
+        QueryPerformanceCounter (&start);
+        for (size_t i=0; i<numListeners; i++){
+            win32_window_add_listener ((Win32Window*) appWindow, distinctEvents ? WM_APP + i : WM_COMMAND,
+                                       on_event, NULL, NULL, LISTENER_NONE);
+        }
+        QueryPerformanceCounter (&end);
+        elapsed += end.QuadPart - start.QuadPart;
+
+        win32_window_unref (appWindow);
+    }
+    return (double) elapsed * 1e9 / frequency.QuadPart / REPETITIONS / numListeners;
+}
+
+
+int main (int argc, char **argv)
+{
+    size_t sizes[] = { 10, 100, 1000, 10000, 100000 };
+
+    printf ("%10s %20s %20s\n", "listeners", "same event (ns)", "distinct events (ns)");
+    for (int i=0; i<G_N_ELEMENTS(sizes); i++){
+        printf ("%10u %20.2f %20.2f\n", (unsigned) sizes[i],
+                measure_registration (sizes[i], FALSE), measure_registration (sizes[i], TRUE));
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define NUM_ROWS     1000000
+#define NUM_COLUMNS  3
+#define NUM_PAGES    2000
+
+static gulong g_cells = 0;
+static gulong g_hints = 0;
+static gulong g_hintedRows = 0;
+
+static char* provide_cell (int row, int column, void *boundData)
+{
+    g_cells += 1;
+    switch (column){
+        case 0:  return g_strdup_printf ("Row %d", row);
+        case 1:  return g_strdup_printf ("%08X", (unsigned) row * 2654435761u);
+        default: return g_strdup_printf ("%d.%02d", row / 100, row % 100);
+    }
+}
+
+static void cache_hint (int first, int last, void *boundData)
+{
+    g_hints += 1;
+    g_hintedRows += last - first + 1;
+}
+
+static void print_counters (const char *title, double elapsed, int pages)
+{
+    printf ("%s: %.2f ms, %.3f ms/page\n", title, elapsed, elapsed / pages);
+    print_counter ("cells provided", g_cells);
+    print_counter ("cache hints", g_hints);
+    print_counter ("hinted rows", g_hintedRows);
+    g_cells = g_hints = g_hintedRows = 0;
+}
+
+// Scrolls the page that starts at the row into view and paints it
+static void scroll_to (HWND hwnd, int row, int perPage)
+{
+    int target = MIN (row + perPage - 1, NUM_ROWS - 1);
+    SendMessage (hwnd, LVM_ENSUREVISIBLE, target, FALSE);
+    UpdateWindow (hwnd);
+}
+
+
+/* BENCHMARK Virtual list view
+------------------------------------------- */
+// A million rows are never stored anywhere, the control asks for the cells it
+// paints. The number of cells provided per page should stay near the number
+// of visible cells, whatever the row count.
+int main (int argc, char **argv)
+{
+    LARGE_INTEGER start;
+
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    Win32ListView *listView = win32_list_view_new ((Win32Window*) appWindow);
+    Win32Window *window = (Win32Window*) listView;
+
+    win32_list_view_add_column (listView, "Name", 120);
+    win32_list_view_add_column (listView, "Hash", 100);
+    win32_list_view_add_column (listView, "Value", 80);
+    win32_list_view_set_data_provider (listView, provide_cell, NULL, NULL);
+    win32_list_view_set_cache_hint (listView, cache_hint, NULL, NULL);
+
+    QueryPerformanceCounter (&start);
+    win32_list_view_set_row_count (listView, NUM_ROWS);
+    printf ("%d rows, %d columns\n", NUM_ROWS, NUM_COLUMNS);
+    printf ("set row count: %.3f ms\n", elapsed_ms (&start));
+
+    win32_application_window_show (appWindow);
+    win32_window_move_and_resize (window, 0, 0, 400, 600);
+    UpdateWindow (window->hwnd);
+    g_cells = g_hints = g_hintedRows = 0;
+
+    int perPage = (int) SendMessage (window->hwnd, LVM_GETCOUNTPERPAGE, 0, 0);
+    printf ("%d rows per page\n", perPage);
+
+    // Page down from the top
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_PAGES; n++) scroll_to (window->hwnd, n * perPage, perPage);
+    print_counters ("sequential pages", elapsed_ms (&start), NUM_PAGES);
+
+    // Jump around the whole range, as dragging the thumb would
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_PAGES; n++) scroll_to (window->hwnd, (int) ((gint64) n * 7919 * perPage % NUM_ROWS), perPage);
+    print_counters ("random pages", elapsed_ms (&start), NUM_PAGES);
+
+    win32_window_unref (window);
+    win32_window_unref (appWindow);
+
+    return 0;
+}
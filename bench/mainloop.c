@@ -0,0 +1,174 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define NUM_SIGNALS  1000
+#define NUM_IDLES    1000000
+
+static HANDLE g_signal = NULL;        // set by the worker, auto-reset
+static HANDLE g_ack = NULL;           // set by the UI thread once a signal is handled
+static LARGE_INTEGER g_signalled;
+static double g_totalLatency = 0;
+static double g_worstLatency = 0;
+static int g_handled = 0;
+static gulong g_idles = 0;
+static Win32MainLoop *g_loop = NULL;
+
+// Signals the UI thread one at a time, waiting for each to be handled
+static gpointer signal_worker (gpointer data)
+{
+    for (int n=0; n<NUM_SIGNALS; n++){
+        Sleep (1);
+        QueryPerformanceCounter (&g_signalled);
+        SetEvent (g_signal);
+        WaitForSingleObject (g_ack, INFINITE);
+    }
+    return NULL;
+}
+
+static void handle_signal (void)
+{
+    double latency = elapsed_ms (&g_signalled);
+    g_totalLatency += latency;
+    if ( latency > g_worstLatency ) g_worstLatency = latency;
+    g_handled += 1;
+    SetEvent (g_ack);
+}
+
+static void report (const char *title, LARGE_INTEGER *start)
+{
+    printf ("%s: %.2f ms\n", title, elapsed_ms (start));
+    printf ("    %-20s %10.3f ms\n", "average latency", g_totalLatency / g_handled);
+    printf ("    %-20s %10.3f ms\n", "worst latency", g_worstLatency);
+}
+
+static void reset (void)
+{
+    g_totalLatency = 0;
+    g_worstLatency = 0;
+    g_handled = 0;
+}
+
+
+/* BASELINE Peek and sleep
+------------------------------------------- */
+// The loop polls the handle between naps, like a GetMessage loop with a timer would
+static void poll_signals (void)
+{
+    LARGE_INTEGER start;
+    reset ();
+
+    QueryPerformanceCounter (&start);
+    GThread *worker = g_thread_new (NULL, signal_worker, NULL);
+    while ( g_handled < NUM_SIGNALS ){
+        MSG msg;
+        while ( PeekMessage (&msg, NULL, 0, 0, PM_REMOVE) ){
+            TranslateMessage (&msg);
+            DispatchMessage (&msg);
+        }
+        if ( WaitForSingleObject (g_signal, 0) == WAIT_OBJECT_0 ) handle_signal ();
+        else Sleep (1);
+    }
+    g_thread_join (worker);
+
+    report ("Peek and Sleep(1)", &start);
+}
+
+
+/* BENCHMARK Handle watch
+------------------------------------------- */
+static gboolean on_signal (HANDLE handle, void *boundData)
+{
+    handle_signal ();
+    if ( g_handled < NUM_SIGNALS ) return TRUE;
+    win32_main_loop_quit (g_loop, 0);
+    return FALSE;
+}
+
+static void watch_signals (void)
+{
+    LARGE_INTEGER start;
+    reset ();
+
+    QueryPerformanceCounter (&start);
+    GThread *worker = g_thread_new (NULL, signal_worker, NULL);
+    win32_main_loop_add_handle (g_loop, g_signal, on_signal, NULL, NULL);
+    win32_main_loop_run (g_loop);
+    g_thread_join (worker);
+
+    report ("MsgWaitForMultipleObjectsEx", &start);
+}
+
+
+/* BENCHMARK Idle handlers
+------------------------------------------- */
+static gboolean on_idle (void *boundData)
+{
+    g_idles += 1;
+    if ( g_idles < NUM_IDLES ) return TRUE;
+    win32_main_loop_quit (g_loop, 0);
+    return FALSE;
+}
+
+static gboolean on_idle_once (void *boundData)
+{
+    return FALSE;
+}
+
+static gboolean on_idle_quit (void *boundData)
+{
+    win32_main_loop_quit (g_loop, 0);
+    return FALSE;
+}
+
+static void run_idles (void)
+{
+    LARGE_INTEGER start;
+    g_idles = 0;
+
+    QueryPerformanceCounter (&start);
+    win32_main_loop_add_idle (g_loop, MAIN_LOOP_PRIORITY_DEFAULT, on_idle, NULL, NULL);
+    win32_main_loop_run (g_loop);
+    double elapsed = elapsed_ms (&start);
+    printf ("Idle handler: %.2f ms, %.0f calls/s\n", elapsed, NUM_IDLES / elapsed * 1e3);
+
+    // Handlers that run once, as deferred work does, in mixed priorities
+    QueryPerformanceCounter (&start);
+    win32_main_loop_add_idle (g_loop, MAIN_LOOP_PRIORITY_LOW + 1, on_idle_quit, NULL, NULL);
+    for (int n=0; n<NUM_IDLES; n++){
+        int priority = (n % 3 - 1) * MAIN_LOOP_PRIORITY_LOW;
+        win32_main_loop_add_idle (g_loop, priority, on_idle_once, NULL, NULL);
+    }
+    win32_main_loop_run (g_loop);
+    elapsed = elapsed_ms (&start);
+    printf ("One-shot idle handlers: %.2f ms, %.0f handlers/s\n", elapsed, NUM_IDLES / elapsed * 1e3);
+}
+
+
+// A worker signals an event, the UI thread waits on it along with its
+// message queue. Polling adds up to a timer tick of latency per signal,
+// the handle watch wakes the thread right away.
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    win32_application_window_create (appWindow);
+
+    g_signal = CreateEvent (NULL, FALSE, FALSE, NULL);
+    g_ack = CreateEvent (NULL, FALSE, FALSE, NULL);
+    g_loop = win32_main_loop_new ();
+
+    printf ("%d signals, %d idle calls\n", NUM_SIGNALS, NUM_IDLES);
+    poll_signals ();
+    watch_signals ();
+    run_idles ();
+
+    win32_main_loop_unref (g_loop);
+    CloseHandle (g_ack);
+    CloseHandle (g_signal);
+    win32_window_unref (appWindow);
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+#define NUM_MESSAGES 1000000
+
+static WNDPROC g_subclassedProc = NULL;
+
+/* BASELINE Instance subclassing
+------------------------------------------- */
+// Controls used to be created from the system class and subclassed after the
+// fact, their procedure looked the window up and chained through a global
+static LRESULT CALLBACK subclass_procedure (HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    LRESULT result;
+    result = win32_window_default_procedure(hwnd, msg, wParam, lParam);
+    if ( result == STOP_PROPAGATION ) return 0;
+
+    return CallWindowProc( g_subclassedProc, hwnd, msg, wParam, lParam);
+}
+
+
+static double measure (HWND hwnd)
+{
+    LARGE_INTEGER frequency, start, end;
+    QueryPerformanceFrequency (&frequency);
+
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_MESSAGES; n++) SendMessage (hwnd, WM_NULL, 0, 0);
+    QueryPerformanceCounter (&end);
+
+    return (double) (end.QuadPart - start.QuadPart) * 1e9 / frequency.QuadPart / NUM_MESSAGES;
+}
+
+
+/* BENCHMARK Message throughput
+------------------------------------------- */
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    Win32Window *button = (Win32Window*) win32_button_new ((Win32Window*) appWindow, "Superclassed");
+    win32_application_window_create (appWindow);
+
+    // The same button, subclassed the old way
+    Win32Window *subclassed = (Win32Window*) win32_button_new ((Win32Window*) appWindow, "Subclassed");
+    HWND hwnd = CreateWindow( L"BUTTON", L"Subclassed", WS_CHILD | BS_PUSHBUTTON, 0, 0, 75, 23,
+                              ((Win32Window*) appWindow)->hwnd, NULL, GetModuleHandle(NULL), NULL );
+    SetWindowLongPtr( hwnd, GWLP_USERDATA, (LONG_PTR) subclassed );
+    g_subclassedProc = (WNDPROC) SetWindowLongPtr( hwnd, GWLP_WNDPROC, (LONG_PTR) subclass_procedure );
+
+    printf ("%d messages per control\n", NUM_MESSAGES);
+    printf ("    %-24s %8.1f ns/message\n", "subclassed instance", measure (hwnd));
+    printf ("    %-24s %8.1f ns/message\n", "superclass", measure (button->hwnd));
+
+    DestroyWindow (hwnd);
+    win32_window_unref (subclassed);
+    win32_window_unref (button);
+    win32_window_unref (appWindow);
+
+    return 0;
+}
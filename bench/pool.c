@@ -0,0 +1,98 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define NUM_CONTROLS  2000
+#define NUM_ROUNDS    100
+
+static Win32LayoutData *data[NUM_CONTROLS];
+
+
+/* BASELINE malloc
+------------------------------------------- */
+// Anchors and layout data used to be allocated one by one with malloc
+static void build_with_malloc (void)
+{
+    for (int i=0; i<NUM_CONTROLS; i++){
+        data[i] = malloc (sizeof(Win32LayoutData));
+        memset (data[i], 0, sizeof(Win32LayoutData));
+        Win32Anchor **edges[] = { &data[i]->left, &data[i]->top, &data[i]->right, &data[i]->bottom };
+        for (int e=0; e<4; e++){
+            *edges[e] = malloc (sizeof(Win32Anchor));
+            memset (*edges[e], 0, sizeof(Win32Anchor));
+            (*edges[e])->ratio = e * 25;
+        }
+    }
+}
+
+static void release_with_malloc (void)
+{
+    for (int i=0; i<NUM_CONTROLS; i++){
+        free (data[i]->left);
+        free (data[i]->top);
+        free (data[i]->right);
+        free (data[i]->bottom);
+        free (data[i]);
+    }
+}
+
+
+/* BENCHMARK Pools
+------------------------------------------- */
+// Builds the positioning of a large form and tears it down again, as a dialog
+// that's opened and closed repeatedly would
+static void build_with_pools (void)
+{
+    for (int i=0; i<NUM_CONTROLS; i++){
+        data[i] = win32_layout_data_new ();
+        Win32Anchor *anchors[] = {
+            win32_anchor_to_parent (0, 8),
+            win32_anchor_to_parent (0, 8 + i * 24),
+            win32_anchor_to_parent (100, -8),
+            win32_anchor_to_parent (0, 28 + i * 24),
+        };
+        win32_layout_data_set_left   (data[i], anchors[0]);
+        win32_layout_data_set_top    (data[i], anchors[1]);
+        win32_layout_data_set_right  (data[i], anchors[2]);
+        win32_layout_data_set_bottom (data[i], anchors[3]);
+        for (int e=0; e<4; e++) win32_anchor_unref (anchors[e]);
+    }
+}
+
+static void release_with_pools (void)
+{
+    for (int i=0; i<NUM_CONTROLS; i++) win32_layout_data_unref (data[i]);
+}
+
+
+int main (int argc, char **argv)
+{
+    LARGE_INTEGER start;
+
+    printf ("%d rounds of %d layout data with 4 anchors each\n", NUM_ROUNDS, NUM_CONTROLS);
+
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_ROUNDS; n++){
+        build_with_malloc ();
+        release_with_malloc ();
+    }
+    printf ("    %-10s %8.2f ms\n", "malloc", elapsed_ms (&start));
+
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_ROUNDS; n++){
+        build_with_pools ();
+        release_with_pools ();
+    }
+    printf ("    %-10s %8.2f ms\n", "pools", elapsed_ms (&start));
+
+    for (int type=0; type<WIN32_NUM_POOLS; type++){
+        printf ("    %-12s %10lu allocations %6lu live %4lu slabs\n", win32_statistics_get_pool_name (type),
+                win32_statistics_get_pool_allocations (type), win32_statistics_get_pool_live (type),
+                win32_statistics_get_pool_slabs (type));
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+#define REPETITIONS 10
+
+/* BENCHMARK Form startup
+------------------------------------------- */
+// Constructs a form with the given number of controls before it has an HWND,
+// then measures the creation of the window, which realizes them. Like a form
+// with tabs, only every tenth control is visible; lazy containers leave the
+// rest without an HWND. Reports the USER objects the form ended up with.
+//
+// A scrolled form shows every control instead, stacked by a relative layout so
+// that most of them are placed below the client area.
+static double measure_startup (int numControls, guint realization, BOOL scrolled, DWORD *userObjects)
+{
+    LARGE_INTEGER frequency, start, end;
+    LONGLONG elapsed = 0;
+    QueryPerformanceFrequency (&frequency);
+
+    Win32Window **controls = malloc (numControls * sizeof(Win32Window*));
+
+    for (int n=0; n<REPETITIONS; n++)
+    {
+        Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+        win32_container_set_realization ((Win32Container*) appWindow, realization);
+        Win32RelativeLayout *layout = NULL;
+        if ( scrolled ){
+            layout = win32_relative_layout_new (8, 5);
+            win32_container_set_layout ((Win32Container*) appWindow, (Win32Layout*) layout);
+        }
+        DWORD objectsBefore = GetGuiResources (GetCurrentProcess (), GR_USEROBJECTS);
+
+        for (int i=0; i<numControls; i++){
+            switch (i % 3){
+                case 0: controls[i] = (Win32Window*) win32_label_new ((Win32Window*) appWindow, "Label"); break;
+                case 1: controls[i] = (Win32Window*) win32_edit_new ((Win32Window*) appWindow, "Edit"); break;
+                case 2: controls[i] = (Win32Window*) win32_button_new ((Win32Window*) appWindow, "Button"); break;
+            }
+            if ( !scrolled ){
+                win32_window_set_visible (controls[i], i % 10 == 0);
+                continue;
+            }
+            win32_window_set_width (controls[i], 100);
+            win32_window_set_height (controls[i], 23);
+
+            Win32Anchor *anchor = win32_anchor_to_parent (0, 0);
+            win32_layout_data_set_left (controls[i]->positioning, anchor);
+            win32_anchor_unref (anchor);
+            if ( i == 0 ) continue;
+
+            anchor = win32_anchor_to_edge (win32_anchor_to_sibling (controls[i-1], 0), EDGE_BOTTOM);
+            win32_layout_data_set_top (controls[i]->positioning, anchor);
+            win32_anchor_unref (anchor);
+        }
+
+        QueryPerformanceCounter (&start);
+        win32_application_window_create (appWindow);
+        QueryPerformanceCounter (&end);
+        elapsed += end.QuadPart - start.QuadPart;
+        *userObjects = GetGuiResources (GetCurrentProcess (), GR_USEROBJECTS) - objectsBefore;
+
+        DestroyWindow (((Win32Window*) appWindow)->hwnd);
+        for (int i=0; i<numControls; i++) win32_window_unref (controls[i]);
+        if ( layout != NULL ) win32_layout_unref (layout);
+        win32_window_unref (appWindow);
+    }
+    free (controls);
+
+    return (double) elapsed * 1e3 / frequency.QuadPart / REPETITIONS;
+}
+
+
+int main (int argc, char **argv)
+{
+    int sizes[] = { 10, 100, 500, 1000 };
+
+    DWORD eagerObjects, lazyObjects;
+
+    for (int scrolled=0; scrolled<2; scrolled++){
+        printf (scrolled ? "\nScrolled form, controls placed by a relative layout\n" : "Form with tabs, every tenth control visible\n");
+        printf ("%10s %14s %14s %14s %14s\n", "controls", "eager (ms)", "USER objects", "lazy (ms)", "USER objects");
+        for (int i=0; i<G_N_ELEMENTS(sizes); i++){
+            double eager = measure_startup (sizes[i], CONTAINER_REALIZE_EAGER, scrolled, &eagerObjects);
+            double lazy  = measure_startup (sizes[i], CONTAINER_REALIZE_LAZY, scrolled, &lazyObjects);
+            printf ("%10d %14.2f %14lu %14.2f %14lu\n", sizes[i], eager, eagerObjects, lazy, lazyObjects);
+        }
+    }
+    return 0;
+}
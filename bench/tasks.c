@@ -0,0 +1,112 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define TEXT_SIZE  (16 << 20)
+#define NUM_TASKS  10000
+
+static char *g_text = NULL;
+static volatile int g_done = 0;
+static gulong g_progress = 0;
+
+static void rot13 (Win32Task *task, void *boundData)
+{
+    for (size_t i=0; i<TEXT_SIZE; i++){
+        if ( task != NULL && i % 65536 == 0 ){
+            if ( win32_task_is_cancelled (task) ) return;
+            win32_task_report_progress (task, (double) i / TEXT_SIZE);
+        }
+        char c = g_text[i];
+        if ( c >= 'a' && c <= 'z' ) g_text[i] = 'a' + (c - 'a' + 13) % 26;
+        else if ( c >= 'A' && c <= 'Z' ) g_text[i] = 'A' + (c - 'A' + 13) % 26;
+    }
+}
+
+static void count_progress (Win32Task *task, double progress, void *boundData)
+{
+    g_progress += 1;
+}
+
+static void count_done (Win32Task *task, void *boundData)
+{
+    g_done += 1;
+}
+
+static void nothing (Win32Task *task, void *boundData)
+{
+}
+
+// Pumps messages until the number of tasks are done, returns the longest time
+// the loop went without looking at its queue
+static double pump_until (int done)
+{
+    LARGE_INTEGER frequency, last, now;
+    QueryPerformanceFrequency (&frequency);
+    QueryPerformanceCounter (&last);
+    double longest = 0;
+
+    while ( g_done < done ){
+        MSG msg;
+        while ( PeekMessage (&msg, NULL, 0, 0, PM_REMOVE) ) DispatchMessage (&msg);
+
+        QueryPerformanceCounter (&now);
+        double gap = (double) (now.QuadPart - last.QuadPart) * 1e3 / frequency.QuadPart;
+        if ( gap > longest ) longest = gap;
+        last = now;
+
+        MsgWaitForMultipleObjects (0, NULL, FALSE, 1, QS_ALLINPUT);
+    }
+    return longest;
+}
+
+
+/* BENCHMARK Tasks
+------------------------------------------- */
+// The longest the message loop is blocked while a 16 MiB text is encoded,
+// in the click handler and on a worker thread. Then the overhead of a task,
+// from start to the completion callback.
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    win32_application_window_create (appWindow);
+    Win32Window *window = (Win32Window*) appWindow;
+
+    g_text = malloc (TEXT_SIZE);
+    for (int i=0; i<TEXT_SIZE; i++) g_text[i] = (i % 64 == 63) ? '\n' : 'a' + i % 26;
+
+    LARGE_INTEGER start;
+    printf ("ROT13 of %d MiB\n", TEXT_SIZE >> 20);
+
+    QueryPerformanceCounter (&start);
+    rot13 (NULL, NULL);
+    printf ("    %-28s %8.2f ms blocked\n", "in the UI thread", elapsed_ms (&start));
+
+    Win32Task *task = win32_task_new (window, rot13, NULL, NULL);
+    win32_task_on_progress (task, count_progress, NULL, NULL);
+    win32_task_on_done (task, count_done, NULL, NULL);
+    QueryPerformanceCounter (&start);
+    win32_task_start (task);
+    double longest = pump_until (1);
+    printf ("    %-28s %8.2f ms blocked, %.2f ms in all, %lu progress messages\n", "on a worker",
+            longest, elapsed_ms (&start), g_progress);
+    win32_task_unref (task);
+
+    g_done = 0;
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_TASKS; n++){
+        task = win32_task_new (window, nothing, NULL, NULL);
+        win32_task_on_done (task, count_done, NULL, NULL);
+        win32_task_start (task);
+        win32_task_unref (task);
+    }
+    pump_until (NUM_TASKS);
+    printf ("%d empty tasks: %.2f us per task\n", NUM_TASKS, elapsed_ms (&start) * 1e3 / NUM_TASKS);
+
+    free (g_text);
+    win32_window_unref (appWindow);
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define TEXT_SIZE  (1 << 20)
+#define NUM_READS  1000
+
+/* BENCHMARK Text reads
+------------------------------------------- */
+// Reading the text of a control used to fetch and convert it on every call,
+// now it is fetched again only after the control reported a change.
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    Win32Window *edit = (Win32Window*) win32_edit_new_multiline ((Win32Window*) appWindow, "");
+    win32_application_window_create (appWindow);
+
+    char *text = malloc (TEXT_SIZE + 1);
+    for (int i=0; i<TEXT_SIZE; i++) text[i] = (i % 64 == 63) ? '\n' : 'a' + i % 26;
+    text[TEXT_SIZE] = 0;
+    win32_window_set_text (edit, text);
+    // lift the default limit so the simulated typing is accepted
+    SendMessage (edit->hwnd, EM_SETLIMITTEXT, 0, 0);
+
+    LARGE_INTEGER start;
+    size_t sum = 0;
+
+    win32_statistics_reset ();
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_READS; n++){
+        // every tenth read follows an edit, as if the user typed
+        if ( n % 10 == 0 ) SendMessage (edit->hwnd, EM_REPLACESEL, FALSE, (LPARAM) L"x");
+        sum += strlen (win32_window_get_text (edit));
+    }
+    double elapsed = elapsed_ms (&start);
+
+    printf ("%d reads of a %d KiB multiline edit: %.2f ms\n", NUM_READS, TEXT_SIZE >> 10, elapsed);
+    for (int counter=0; counter<WIN32_NUM_CACHE_COUNTERS; counter++) print_cache_count (counter);
+    print_call_count (WIN32_CALL_GET_WINDOW_TEXT);
+
+    free (text);
+    win32_window_unref (edit);
+    win32_window_unref (appWindow);
+
+    return sum == 0;
+}
@@ -0,0 +1,102 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#define FANOUT       100
+#define DEPTH        4     // FANOUT^DEPTH leaves, about a hundred million nodes in all
+#define NUM_BROWSES  500
+
+static gulong g_loads = 0;
+
+// Nodes are numbered level by level, the children of node k are k*FANOUT+1 to
+// k*FANOUT+FANOUT and the roots are the children of 0
+static int depth_of (gintptr key)
+{
+    int depth = 0;
+    while ( key > 0 ){
+        key = (key - 1) / FANOUT;
+        depth++;
+    }
+    return depth;
+}
+
+static void provide_children (Win32TreeView *tree, HTREEITEM parent, void *boundData)
+{
+    gintptr key = win32_tree_view_get_key (tree, parent);
+    char text[32];
+
+    g_loads += 1;
+    for (int i=1; i<=FANOUT; i++){
+        snprintf (text, sizeof(text), "Node %ld", (long) (key * FANOUT + i));
+        win32_tree_view_insert (tree, parent, text, key * FANOUT + i);
+    }
+}
+
+static gboolean has_children (Win32TreeView *tree, HTREEITEM item, void *boundData)
+{
+    return depth_of (win32_tree_view_get_key (tree, item)) < DEPTH;
+}
+
+static HTREEITEM nth_child (Win32TreeView *tree, HTREEITEM parent, int n)
+{
+    HWND hwnd = ((Win32Window*) tree)->hwnd;
+    HTREEITEM item = (HTREEITEM) SendMessage (hwnd, TVM_GETNEXTITEM, ( parent != NULL ) ? TVGN_CHILD : TVGN_ROOT, (LPARAM) parent);
+    while ( item != NULL && n-- > 0 ) item = (HTREEITEM) SendMessage (hwnd, TVM_GETNEXTITEM, TVGN_NEXT, (LPARAM) item);
+    return item;
+}
+
+// Opens a random path down to a leaf and closes it again, like a user looking
+// for a file
+static void browse (Win32TreeView *tree, const char *title)
+{
+    LARGE_INTEGER start;
+    HTREEITEM path[DEPTH];
+    guint seed = 1;
+
+    g_loads = 0;
+    QueryPerformanceCounter (&start);
+    for (int n=0; n<NUM_BROWSES; n++){
+        HTREEITEM item = NULL;
+        for (int d=0; d<DEPTH - 1; d++){
+            seed = seed * 1103515245 + 12345;
+            item = nth_child (tree, item, (seed >> 16) % FANOUT);
+            win32_tree_view_expand (tree, item);
+            path[d] = item;
+        }
+        for (int d=DEPTH - 2; d>=0; d--) win32_tree_view_collapse (tree, path[d]);
+    }
+    printf ("%s: %.2f ms\n", title, elapsed_ms (&start));
+    print_counter ("children loads", g_loads);
+    print_counter ("items loaded", win32_tree_view_get_item_count (tree));
+}
+
+
+/* BENCHMARK Lazy tree view
+------------------------------------------- */
+// Only the expanded branches exist in the control. When collapsed branches are
+// released, the item count stays at the roots whatever was browsed.
+int main (int argc, char **argv)
+{
+    Win32ApplicationWindow *appWindow = win32_application_window_new ("Benchmark");
+    Win32TreeView *tree = win32_tree_view_new ((Win32Window*) appWindow);
+    win32_application_window_show (appWindow);
+    win32_window_move_and_resize ((Win32Window*) tree, 0, 0, 400, 600);
+
+    win32_tree_view_set_children_query (tree, has_children, NULL, NULL);
+    win32_tree_view_set_children_provider (tree, provide_children, NULL, NULL);
+
+    printf ("%d browses %d levels deep, %d children per node\n", NUM_BROWSES, DEPTH - 1, FANOUT);
+    browse (tree, "collapsed branches kept");
+
+    win32_tree_view_reload (tree);
+    win32_tree_view_set_release_collapsed (tree, TRUE);
+    browse (tree, "collapsed branches released");
+
+    win32_window_unref ((Win32Window*) tree);
+    win32_window_unref (appWindow);
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+// Built natively with the host compiler, and for Windows where the results are
+// also compared against MultiByteToWideChar and WideCharToMultiByte.
+#include "unicode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define MAX_TEXT       4096
+#define FUZZ_ROUNDS    100000
+#define REPETITIONS    200000
+
+/* REFERENCE
+------------------------------------------- */
+// Straightforward one code point at a time encoders, used to produce the
+// expected results of well-formed input
+static size_t encode_utf8 (const uint32_t *codePoints, size_t count, char *dst)
+{
+    unsigned char *bytes = (unsigned char*) dst;
+    size_t j = 0;
+    for (size_t i=0; i<count; i++){
+        uint32_t c = codePoints[i];
+        if ( c < 0x80 ) bytes[j++] = c;
+        else if ( c < 0x800 ){
+            bytes[j++] = 0xC0 | (c >> 6);
+            bytes[j++] = 0x80 | (c & 0x3F);
+        } else if ( c < 0x10000 ){
+            bytes[j++] = 0xE0 | (c >> 12);
+            bytes[j++] = 0x80 | ((c >> 6) & 0x3F);
+            bytes[j++] = 0x80 | (c & 0x3F);
+        } else {
+            bytes[j++] = 0xF0 | (c >> 18);
+            bytes[j++] = 0x80 | ((c >> 12) & 0x3F);
+            bytes[j++] = 0x80 | ((c >> 6) & 0x3F);
+            bytes[j++] = 0x80 | (c & 0x3F);
+        }
+    }
+    return j;
+}
+
+static size_t encode_utf16 (const uint32_t *codePoints, size_t count, uint16_t *dst)
+{
+    size_t j = 0;
+    for (size_t i=0; i<count; i++){
+        uint32_t c = codePoints[i];
+        if ( c < 0x10000 ) dst[j++] = c;
+        else {
+            dst[j++] = 0xD800 | ((c - 0x10000) >> 10);
+            dst[j++] = 0xDC00 | ((c - 0x10000) & 0x3FF);
+        }
+    }
+    return j;
+}
+
+// Mostly ASCII runs of random length so that the vector loops are entered and
+// left at every offset, with the other planes sprinkled in
+static size_t random_code_points (uint32_t *codePoints, size_t maxCount)
+{
+    size_t count = rand () % maxCount;
+    for (size_t i=0; i<count; i++){
+        int kind = rand () % 16;
+        if ( kind < 12 )       codePoints[i] = 1 + rand () % 0x7F;
+        else if ( kind == 12 ) codePoints[i] = 0x80 + rand () % (0x800 - 0x80);
+        else if ( kind == 13 ) codePoints[i] = 0x800 + rand () % (0xD800 - 0x800);
+        else if ( kind == 14 ) codePoints[i] = 0xE000 + rand () % (0x10000 - 0xE000);
+        else                   codePoints[i] = 0x10000 + rand () % (0x110000 - 0x10000);
+    }
+    return count;
+}
+
+
+/* TEST Ill-formed input
+------------------------------------------- */
+// The example of the Unicode standard, section 3.9 "U+FFFD Substitution of Maximal Subparts"
+static int check_ill_formed (void)
+{
+    const char input[] = "\x61\xF1\x80\x80\xE1\x80\xC2\x62\x80\x63\x80\xBF\x64";
+    const uint16_t expected[] = { 0x61, 0xFFFD, 0xFFFD, 0xFFFD, 0x62, 0xFFFD, 0x63, 0xFFFD, 0xFFFD, 0x64 };
+    uint16_t output[sizeof(input)];
+
+    size_t length = win32_utf8_to_utf16 (input, sizeof(input) - 1, output);
+    if ( length != sizeof(expected) / sizeof(expected[0]) || memcmp (output, expected, sizeof(expected)) != 0 ){
+        printf ("ill-formed UTF-8 is not replaced by maximal subparts\n");
+        return 1;
+    }
+
+    const uint16_t lone[] = { 0x41, 0xDC00, 0x42, 0xD800 };
+    char narrow[UTF8_MAX_LENGTH(4)];
+    length = win32_utf16_to_utf8 (lone, 4, narrow);
+    if ( length != 8 || memcmp (narrow, "A\xEF\xBF\xBD" "B\xEF\xBF\xBD", 8) != 0 ){
+        printf ("unpaired surrogates are not replaced\n");
+        return 1;
+    }
+    return 0;
+}
+
+
+/* TEST Fuzzing
+------------------------------------------- */
+static int fuzz (void)
+{
+    static uint32_t codePoints[MAX_TEXT];
+    static char utf8[MAX_TEXT * 4], narrow[UTF8_MAX_LENGTH(MAX_TEXT * 2)];
+    static uint16_t utf16[MAX_TEXT * 2], wide[MAX_TEXT * 4];
+    int failures = check_ill_formed ();
+
+    for (int n=0; n<FUZZ_ROUNDS; n++){
+        size_t count = random_code_points (codePoints, (n % 2) ? 64 : MAX_TEXT);
+        size_t utf8Length  = encode_utf8 (codePoints, count, utf8);
+        size_t utf16Length = encode_utf16 (codePoints, count, utf16);
+
+        size_t wideLength = win32_utf8_to_utf16 (utf8, utf8Length, wide);
+        if ( wideLength != utf16Length || memcmp (wide, utf16, utf16Length * 2) != 0 ){
+            failures++;
+            continue;
+        }
+        size_t narrowLength = win32_utf16_to_utf8 (utf16, utf16Length, narrow);
+        if ( narrowLength != utf8Length || memcmp (narrow, utf8, utf8Length) != 0 ){
+            failures++;
+            continue;
+        }
+#ifdef _WIN32
+        int apiLength = MultiByteToWideChar (CP_UTF8, 0, utf8, utf8Length, (wchar_t*) wide, MAX_TEXT * 4);
+        if ( apiLength != (int) utf16Length || memcmp (wide, utf16, utf16Length * 2) != 0 ) failures++;
+        apiLength = WideCharToMultiByte (CP_UTF8, 0, (wchar_t*) utf16, utf16Length, narrow, sizeof(narrow), NULL, NULL);
+        if ( apiLength != (int) utf8Length || memcmp (narrow, utf8, utf8Length) != 0 ) failures++;
+#endif
+    }
+    printf ("%d rounds, %d failures\n", FUZZ_ROUNDS, failures);
+    return failures != 0;
+}
+
+
+/* BENCHMARK Conversions
+------------------------------------------- */
+static double seconds (void)
+{
+    struct timespec now;
+    timespec_get (&now, TIME_UTC);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void measure (const char *title, const char *text)
+{
+    static uint16_t wide[MAX_TEXT];
+    static char narrow[UTF8_MAX_LENGTH(MAX_TEXT)];
+    size_t length = strlen (text), wideLength = 0, checksum = 0;
+
+    double start = seconds ();
+    for (int n=0; n<REPETITIONS; n++){
+        wideLength = win32_utf8_to_utf16 (text, length, wide);
+        checksum += wide[n % wideLength];
+    }
+    double widen = (seconds () - start) * 1e9 / REPETITIONS;
+
+    start = seconds ();
+    for (int n=0; n<REPETITIONS; n++){
+        checksum += win32_utf16_to_utf8 (wide, wideLength, narrow);
+    }
+    double narrowing = (seconds () - start) * 1e9 / REPETITIONS;
+    printf ("%-24s %6u %16.1f %16.1f\n", title, (unsigned) length, widen, narrowing);
+
+#ifdef _WIN32
+    start = seconds ();
+    for (int n=0; n<REPETITIONS; n++){
+        checksum += MultiByteToWideChar (CP_UTF8, 0, text, length, (wchar_t*) wide, MAX_TEXT);
+    }
+    widen = (seconds () - start) * 1e9 / REPETITIONS;
+
+    start = seconds ();
+    for (int n=0; n<REPETITIONS; n++){
+        checksum += WideCharToMultiByte (CP_UTF8, 0, (wchar_t*) wide, wideLength, narrow, sizeof(narrow), NULL, NULL);
+    }
+    narrowing = (seconds () - start) * 1e9 / REPETITIONS;
+    printf ("%-24s %6s %16.1f %16.1f\n", "    Win32 API", "", widen, narrowing);
+#endif
+    if ( checksum == 0 ) printf ("\n");
+}
+
+int main (int argc, char **argv)
+{
+    srand (1);
+    if ( argc > 1 && strcmp (argv[1], "--fuzz") == 0 ) return fuzz ();
+
+    static char ascii[1025];
+    memset (ascii, 'a', 1024);
+
+    printf ("%-24s %6s %16s %16s\n", "text", "bytes", "to UTF-16 (ns)", "to UTF-8 (ns)");
+    measure ("button caption", "Encrypt");
+    measure ("label", "Select the file to be encrypted:");
+    measure ("ascii paragraph", ascii);
+    measure ("mixed", "Dosya se\xC3\xA7ilmedi, l\xC3\xBC" "tfen tekrar deneyin. \xE2\x9C\x93 \xF0\x9F\x94\x92");
+    return 0;
+}
@@ -8,7 +8,9 @@ using Gee;
 
 namespace ROT13 {
 
-    string encode(string? text)
+    // Reports its progress to the task it runs in, if any, and stops early
+    // when the task is cancelled
+    string encode(string? text, Task? task = null)
     {
         var buffer = new StringBuilder();
 
@@ -22,6 +24,10 @@ namespace ROT13 {
         // a byte long and equivalent to the corresponding ASCII code.
         for (int i=0; i < byte_array.length; i++)
         {
+            if (task != null && i % 65536 == 0){
+                if (task.is_cancelled()) break;
+                task.report_progress((double) i / byte_array.length);
+            }
             byte = byte_array[i];
 
             if (byte >= 'A' && byte <= 'Z'){
@@ -45,6 +51,7 @@ class Application
 
     private ApplicationWindow appWindow;
     private UIElements ui;
+    private Task? encoding = null;
 
     public Application()
     {
@@ -198,7 +205,26 @@ class Application
         });
 
         ui.buttons["encode"].add_listener( Event.CLICK, (event) => {
-            ui.edits["output"].text = ROT13.encode( ui.edits["input"].text );
+            // A previous run that hasn't finished yet is superseded
+            if (encoding != null) encoding.cancel();
+
+            string input = ui.edits["input"].text;
+            string? output = null;
+            // Large texts are encoded on a worker thread, the window stays responsive
+            var task = new Task(appWindow, (running) => {
+                output = ROT13.encode(input, running);
+            });
+            task.on_progress((running, progress) => {
+                appWindow.text = "ROT-13 Encoder/Decoder - %d%%".printf((int) (progress * 100));
+            });
+            task.on_done((finished) => {
+                if (finished.is_cancelled()) return;
+                ui.edits["output"].text = output;
+                appWindow.text = "ROT-13 Encoder/Decoder";
+                encoding = null;
+            });
+            encoding = task;
+            task.start();
         });
 
         ui.buttons["help"].add_listener( Event.CLICK, (event) => {
@@ -224,14 +250,8 @@ class Application
 
     public int run()
     {
-        Message msg;
         // The Windows Message Loop
-        while ( get_message(out msg) > 0)
-        {
-            translate_message(ref msg);
-            dispatch_message (ref msg);
-        }
-        return (int) msg.wParam;
+        return new MainLoop().run();
     }
 }
 
@@ -242,5 +262,8 @@ int main (string[] argv) {
     app.display();
     app.run();
 
+    // Built with -DWIN32_PROFILING, where the UI time went
+    if ( Profiling.is_enabled() ) Profiling.dump("encryptor-profile.txt");
+
     return 0;
 }
\ No newline at end of file
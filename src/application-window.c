@@ -9,6 +9,7 @@ static const wchar_t *szClassName = L"WindowClass";
 static gpointer win32_application_window_parent_class = NULL;
 
 static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+static void layout_callback ( Win32Event *event, void *boundData );
 static void win32_application_window_finalize (Win32Window * obj);
 static GType win32_application_window_get_type_once (void);
 
@@ -31,6 +32,9 @@ Win32ApplicationWindow* win32_application_window_construct (GType object_type, c
     window->width  = CW_USEDEFAULT;    // initial x size
     window->height = CW_USEDEFAULT;    // initial y size
 
+    // Layout children once per loop turn, and once per frame during live resize
+    win32_window_insert_into_callback_queue( window, WM_SIZE, layout_callback, NULL, NULL, LISTENER_COALESCE );
+
     return self;
 }
 
@@ -46,13 +50,14 @@ void win32_application_window_create (Win32ApplicationWindow *self)
 {
     HWND hwnd;
     Win32Window * window = (Win32Window*) self;
-    wchar_t *text = fromUTF8(window->text);
+    Win32WideString text;
+    win32_wide_string_init( &text, window->text );
 
     // Creating the Window
     hwnd = CreateWindowEx(
         0, // WS_EX_CLIENTEDGE,
         szClassName,
-        text,
+        text.str,
         WS_OVERLAPPEDWINDOW,
         window->left,
         window->top,
@@ -62,13 +67,15 @@ void win32_application_window_create (Win32ApplicationWindow *self)
         window->hInstance,
         window );
 
-    free(text);
+    win32_wide_string_release( &text );
 
     if(hwnd == NULL)
     {
         MessageBox(NULL, L"Window Creation Failed!", L"Error!", MB_ICONEXCLAMATION | MB_OK);
         exit (1);  //exit
     }
+    // The default position and size are chosen by the system
+    win32_window_sync_geometry (window);
 }
 
 
@@ -86,10 +93,25 @@ void win32_application_window_show(Win32ApplicationWindow *self)
         win32_application_window_create( self );
     }
     ShowWindow (window->hwnd, SW_NORMAL);
+    // Lay the children out before the first paint
+    win32_window_flush_coalesced (window);
     UpdateWindow (window->hwnd);
 }
 
 
+/* INTERNAL LAYOUT CALLBACK
+------------------------------------------- */
+static void layout_callback ( Win32Event *event, void *boundData )
+{
+    Win32Container *container = (Win32Container *) event->source;
+    if ( container->layout == NULL ) return;
+
+    WIN32_PROFILE_BEGIN (start);
+    container->layout->recalculate (container);
+    WIN32_PROFILE_END (WIN32_TIMER_LAYOUT, start);
+}
+
+
 /* PROPERTY SET MIN-WIDTH
 ------------------------------------------- */
 void win32_application_window_set_min_width  (Win32ApplicationWindow *self, INT min_width)
@@ -152,12 +174,13 @@ INT  win32_application_window_get_max_height (Win32ApplicationWindow *self)
 // the Window Procedure
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    WIN32_PROFILE_BEGIN (start);
     static Win32ApplicationWindow *applicationWindow = NULL;
     if (!applicationWindow) applicationWindow = (Win32ApplicationWindow*) GetWindowLongPtr( hwnd, GWLP_USERDATA);
 
     LRESULT result;
     result = win32_window_default_procedure(hwnd, msg, wParam, lParam);
-    if ( result == STOP_PROPAGATION ) return 0;
+    if ( result == STOP_PROPAGATION ) return WIN32_PROFILE_MESSAGE (msg, start, 0);
 
     static HBRUSH hbrush = NULL;
 
@@ -165,24 +188,28 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
     {
         case WM_COMMAND:
             // Forward message
-            if ( (HWND) lParam != NULL ) SendMessage( (HWND) lParam, FM_COMMAND, 0, 0 );
-            return 0;
+            if ( (HWND) lParam != NULL ) SendMessage( (HWND) lParam, FM_COMMAND, wParam, 0 );
+            return WIN32_PROFILE_MESSAGE (msg, start, 0);
+
+        case WM_NOTIFY: {
+            // Forward message, the control answers the notification
+            NMHDR *header = (NMHDR*) lParam;
+            if ( header->hwndFrom != NULL ) return WIN32_PROFILE_MESSAGE (msg, start, SendMessage( header->hwndFrom, FM_NOTIFY, wParam, lParam ));
+            break; }
 
         case WM_GETMINMAXINFO: {//window's size/position is about to change
-            if (!applicationWindow) return 0;
+            if (!applicationWindow) return WIN32_PROFILE_MESSAGE (msg, start, 0);
             // lParam is a pointer to MINMAXINFO structure
             LPMINMAXINFO lpMMI = (LPMINMAXINFO) lParam;
             if (applicationWindow->min_width  > 0 ) lpMMI->ptMinTrackSize.x = applicationWindow->min_width;
             if (applicationWindow->min_height > 0 ) lpMMI->ptMinTrackSize.y = applicationWindow->min_height;
             if (applicationWindow->max_width  > applicationWindow->min_width ) lpMMI->ptMaxTrackSize.x = applicationWindow->max_width;
             if (applicationWindow->max_height > applicationWindow->min_height) lpMMI->ptMaxTrackSize.y = applicationWindow->max_height;
-            return 0; }
+            return WIN32_PROFILE_MESSAGE (msg, start, 0); }
 
-        case WM_SIZE: {
-            // Layout children
-            Win32Container *container = (Win32Container *) applicationWindow;
-            if ( container->layout != NULL) container->layout->recalculate (container);
-            return 0; }
+        case WM_SIZE:
+            // Children are laid out by a coalescing listener, see the constructor
+            return WIN32_PROFILE_MESSAGE (msg, start, 0);
 
         case WM_CLOSE:
             DestroyWindow(hwnd);
@@ -193,7 +220,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
             break;
     }
 
-    return DefWindowProc(hwnd, msg, wParam, lParam);
+    return WIN32_PROFILE_MESSAGE (msg, start, DefWindowProc(hwnd, msg, wParam, lParam));
 }
 
 
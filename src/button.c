@@ -6,7 +6,8 @@
 #include "vala-win32.h"
 #include <stdio.h>
 
-static WNDPROC g_controlProc = NULL;
+static const wchar_t *szClassName = L"Win32Button";
+static WNDPROC g_baseProc = NULL;  // procedure of the system class, see the superclass
 static gpointer win32_button_parent_class = NULL;
 
 static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -43,12 +44,13 @@ HWND win32_button_create (Win32Window *self, Win32Window *parent)
     window->height = (window->pref_height > 0) ? window->pref_height : 23;
 
     control->id = win32_control_generate_ID();
-    wchar_t *text = fromUTF8(window->text);
+    Win32WideString text;
+    win32_wide_string_init( &text, window->text );
 
     // Creating the Window
     hwnd = CreateWindow(
-        L"BUTTON",
-        text,
+        szClassName,
+        text.str,
         // Control Styles:
         WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_PUSHBUTTON,
         window->left,   // x position
@@ -58,13 +60,11 @@ HWND win32_button_create (Win32Window *self, Win32Window *parent)
         parent->hwnd,   // Parent window
         (HANDLE) control->id, // Control ID
         window->hInstance,
-        NULL );
+        window );
 
-    window->hwnd = hwnd;
+    // window->hwnd is assigned on WM_NCCREATE
 
-    g_controlProc = (WNDPROC) SetWindowLongPtr( hwnd, GWLP_WNDPROC, (LONG_PTR) WndProc );
-
-    free(text);
+    win32_wide_string_release( &text );
 
     return hwnd;
 }
@@ -75,11 +75,12 @@ HWND win32_button_create (Win32Window *self, Win32Window *parent)
 // the Window Procedure
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    WIN32_PROFILE_BEGIN (start);
     LRESULT result;
     result = win32_window_default_procedure(hwnd, msg, wParam, lParam);
-    if ( result == STOP_PROPAGATION ) return 0;
+    if ( result == STOP_PROPAGATION ) return WIN32_PROFILE_MESSAGE (msg, start, 0);
 
-    return CallWindowProc( g_controlProc, hwnd, msg, wParam, lParam);
+    return WIN32_PROFILE_MESSAGE (msg, start, CallWindowProc( g_baseProc, hwnd, msg, wParam, lParam));
 }
 
 
@@ -89,6 +90,13 @@ static void win32_button_class_init (Win32ButtonClass * klass, gpointer klass_da
 {
     win32_button_parent_class = g_type_class_peek_parent (klass);
     ((Win32WindowClass *) klass)->finalize = win32_button_finalize;
+
+    // Register the superclass once, every button shares it
+    g_baseProc = win32_control_register_superclass( L"BUTTON", szClassName, WndProc );
+    if ( g_baseProc == NULL ){
+        MessageBox(NULL, L"Window Registration Failed!", L"Error!", MB_ICONEXCLAMATION | MB_OK);
+        exit (1); // exit
+    }
 }
 
 static void win32_button_instance_init (Win32Button * self, gpointer klass)
@@ -18,10 +18,10 @@ void win32_clipboard_set_text(const char* text)
     if (!OpenClipboard(NULL)) return;
     EmptyClipboard();
 
-    int length = MultiByteToWideChar(CP_UTF8, 0, text, -1, 0, 0);
+    size_t length = strlen(text);
 
-    // Allocate a global memory object for the text.
-    hmem = GlobalAlloc(GMEM_MOVEABLE, (length) * sizeof(wchar_t));
+    // Allocate a global memory object for the text, large enough to convert in one pass.
+    hmem = GlobalAlloc(GMEM_MOVEABLE, (UTF16_MAX_LENGTH(length) + 1) * sizeof(wchar_t));
 
     if (hmem == NULL){
         CloseClipboard();
@@ -30,7 +30,7 @@ void win32_clipboard_set_text(const char* text)
 
     // Lock the handle and copy the text to the buffer.
     buffer = GlobalLock(hmem);
-    MultiByteToWideChar(CP_UTF8, 0, text, -1, buffer, length);
+    buffer[ win32_utf8_to_utf16 (text, length, (uint16_t*) buffer) ] = 0;
     GlobalUnlock(hmem);
 
     // Place the handle on the clipboard.
@@ -72,7 +72,7 @@ char* win32_clipboard_get_text(void)
 BOOL win32_clipboard_add_format_listener (Win32Window *window)
 {
     if (window->hwnd) return AddClipboardFormatListener(window->hwnd);
-    win32_window_insert_into_callback_queue( window, WM_CREATE, add_format_listener_callback, NULL, NULL );
+    win32_window_insert_into_callback_queue( window, WM_CREATE, add_format_listener_callback, NULL, NULL, LISTENER_NONE );
     return FALSE;
 }
 
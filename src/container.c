@@ -8,6 +8,8 @@
 static gpointer win32_container_parent_class = NULL;
 
 static void  win32_container_finalize (Win32Window * obj);
+static void  win32_container_flush_geometry (Win32Window *window, HDWP *transaction);
+static void  win32_container_realize (Win32Window *window);
 static GType win32_container_get_type_once (void);
 
 
@@ -22,6 +24,7 @@ Win32Container* win32_container_construct (GType object_type)
     self->childWindows.items = malloc( sizeof(Win32Window*) * INITIAL_LIST_SIZE );
     memset( self->childWindows.items, 0, sizeof(Win32Window*) * INITIAL_LIST_SIZE );
     self->childWindows.length = 0;
+    self->childWindows.capacity = INITIAL_LIST_SIZE;
 
     return self;
 }
@@ -45,22 +48,21 @@ Win32Window ** win32_container_get_children (Win32Container *self, size_t *lengt
 ------------------------------------------- */
 void win32_container_add_child (Win32Container *self, Win32Window *child)
 {
-    Win32Window * window = (Win32Window*) self;
     Win32WindowList *childList = &self->childWindows;
     size_t length = childList->length;
 
-    // Check if we have enough room in the list
-    if ( (length+1) % INITIAL_LIST_SIZE == 0 ){
-        childList->items = realloc(childList->items, sizeof(Win32Window *) * ((length + 1) + INITIAL_LIST_SIZE) );
+    // Double the list whenever it fills up
+    if ( length == childList->capacity ){
+        childList->items = realloc(childList->items, sizeof(Win32Window *) * childList->capacity * 2 );
         // Initialize newly added slots
-        memset( childList->items + (length + 1), 0, sizeof(Win32Window *) * INITIAL_LIST_SIZE );
+        memset( childList->items + length, 0, sizeof(Win32Window *) * childList->capacity );
+        childList->capacity *= 2;
     }
     childList->items[ length ] = win32_window_ref( child );
     childList->length += 1;
 
-    // Update layout if there is any
-    if (window->hwnd && self->layout) self->layout->configure(self);
-
+    // The plan is rebuilt once, by the next recalculation
+    if ( self->layout != NULL ) self->layout->stale = TRUE;
 }
 
 
@@ -78,6 +80,8 @@ void win32_container_set_layout  (Win32Container *self, Win32Layout *layout)
     win32_layout_ref( layout );
 
     self->layout = layout;
+    // The new layout plans the children with its first recalculation
+    layout->stale = TRUE;
 }
 
 
@@ -89,6 +93,131 @@ Win32Layout *win32_container_get_layout  (Win32Container *self)
 }
 
 
+/* INTERNAL VIRTUAL METHOD
+------------------------------------------- */
+// The children are moved in the same transaction as the container
+static void win32_container_flush_geometry (Win32Window *window, HDWP *transaction)
+{
+    Win32Container *self = (Win32Container*) window;
+    Win32Window *child;
+
+    WIN32_WINDOW_CLASS (win32_container_parent_class)->flush_geometry (window, transaction);
+
+    for ( int i =0; i < self->childWindows.length; i++ ){
+        child = self->childWindows.items[i];
+        WIN32_WINDOW_GET_CLASS (child)->flush_geometry (child, transaction);
+    }
+}
+
+
+/* INTERNAL VISIBILITY
+------------------------------------------- */
+// Whether the child overlaps the area, grown by `distance` times its size on each side
+static BOOL win32_container_child_in_area (Win32Window *child, const RECT *area, int distance)
+{
+    int marginX = (area->right - area->left) * distance;
+    int marginY = (area->bottom - area->top) * distance;
+    // a child yet to be sized still counts at its position
+    int width  = MAX (child->width, 1);
+    int height = MAX (child->height, 1);
+
+    return child->left < area->right + marginX && child->left + width  > area->left - marginX &&
+           child->top  < area->bottom + marginY && child->top + height > area->top - marginY;
+}
+
+
+/* INTERNAL VISIBILITY
+------------------------------------------- */
+// Whether a child added to the realized container has to be created right away
+BOOL win32_container_child_needs_realize (Win32Container *self, Win32Window *child)
+{
+    RECT area;
+
+    if ( self->realization == CONTAINER_REALIZE_EAGER ) return TRUE;
+    if ( !child->visible ) return FALSE;
+
+    WIN32_COUNT_CALL (WIN32_CALL_GET_CLIENT_RECT);
+    GetClientRect (((Win32Window*) self)->hwnd, &area);
+    return win32_container_child_in_area (child, &area, 0);
+}
+
+
+/* INTERNAL VIRTUAL METHOD
+------------------------------------------- */
+// Creates the pending controls in a single pass, with drawing and geometry
+// changes held until the last one. Lazy containers only create the controls
+// that can be seen and, when recycling, destroy the ones far outside.
+static void win32_container_realize (Win32Window *window)
+{
+    Win32Container *self = (Win32Container*) window;
+    HFONT font = win32_get_default_gui_font();
+    Win32Window *child;
+    RECT area;
+    int numCreated = 0;
+
+    if ( self->childWindows.length == 0 || self->realizing ) return;
+    // Controls being created resize themselves, the container is laid out once at the end
+    self->realizing = TRUE;
+
+    BOOL lazy = self->realization != CONTAINER_REALIZE_EAGER;
+    if ( lazy ){
+        WIN32_COUNT_CALL (WIN32_CALL_GET_CLIENT_RECT);
+        GetClientRect (window->hwnd, &area);
+        // Children placed by the layout have no position before its first pass
+        if ( self->layout != NULL ){
+            WIN32_PROFILE_BEGIN (start);
+            self->layout->recalculate (self);
+            WIN32_PROFILE_END (WIN32_TIMER_LAYOUT, start);
+        }
+    }
+
+    win32_window_begin_update (window);
+    for ( int i =0; i < self->childWindows.length; i++ ){
+        child = self->childWindows.items[i];
+        if ( !WIN32_IS_CONTROL (child) ) continue;
+
+        if ( !lazy || (child->visible && win32_container_child_in_area (child, &area, 0)) ){
+            if ( child->hwnd != NULL ) continue;
+            win32_control_realize ((Win32Control*) child, font);
+            // the new control takes its size from the creator, let the layout place it again
+            win32_layout_data_invalidate (child->positioning, EDGE_ALL);
+            numCreated += 1;
+        } else if ( self->realization == CONTAINER_REALIZE_RECYCLE &&
+                    !win32_container_child_in_area (child, &area, RECYCLE_DISTANCE) ){
+            win32_control_unrealize ((Win32Control*) child);
+        }
+    }
+    if ( numCreated > 0 && self->layout != NULL ){
+        WIN32_PROFILE_BEGIN (start);
+        self->layout->recalculate (self);
+        WIN32_PROFILE_END (WIN32_TIMER_LAYOUT, start);
+    }
+    win32_window_end_update (window);
+
+    self->realizing = FALSE;
+}
+
+
+/* PROPERTY SET REALIZATION
+------------------------------------------- */
+void win32_container_set_realization (Win32Container *self, guint realization)
+{
+    if ( realization > CONTAINER_REALIZE_RECYCLE ) return;
+    self->realization = realization;
+
+    Win32Window *window = (Win32Window*) self;
+    if ( window->hwnd != NULL ) WIN32_WINDOW_GET_CLASS (window)->realize (window);
+}
+
+
+/* PROPERTY GET REALIZATION
+------------------------------------------- */
+guint win32_container_get_realization (Win32Container *self)
+{
+    return self->realization;
+}
+
+
 /* INTERNAL GTYPE
 ------------------------------------------- */
 static void win32_container_class_init (Win32ContainerClass * klass, gpointer klass_data)
@@ -96,6 +225,8 @@ static void win32_container_class_init (Win32ContainerClass * klass, gpointer kl
     win32_container_parent_class = g_type_class_peek_parent (klass);
     // Overrides
     ((Win32WindowClass *) klass)->finalize = win32_container_finalize;
+    ((Win32WindowClass *) klass)->flush_geometry = win32_container_flush_geometry;
+    ((Win32WindowClass *) klass)->realize = win32_container_realize;
 }
 
 static void win32_container_instance_init (Win32Container * self, gpointer klass)
@@ -10,6 +10,13 @@
 #include <glib-object.h>
 #include "window.h"
 
+// When the controls of a container get their HWND
+#define CONTAINER_REALIZE_EAGER    0   // all of them, when the container is created
+#define CONTAINER_REALIZE_LAZY     1   // once they are visible and inside the client area
+#define CONTAINER_REALIZE_RECYCLE  2   // like LAZY, destroyed again when they move far outside
+
+#define RECYCLE_DISTANCE  1   // "far outside": farther than this many client sizes
+
 typedef struct _Win32WindowList Win32WindowList;
 
 typedef struct _Win32ContainerClass Win32ContainerClass;
@@ -28,12 +35,15 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC (Win32Container, win32_window_unref)
 struct _Win32WindowList {
     Win32Window ** items;
     size_t length;
+    size_t capacity;
 };
 
 struct _Win32Container {
     Win32Window parent_instance;
     Win32WindowList childWindows;
     Win32Layout * layout;
+    guint realization;      // see CONTAINER_REALIZE_* constants
+    BOOL  realizing;
 };
 
 struct _Win32ContainerClass {
@@ -43,9 +53,12 @@ struct _Win32ContainerClass {
 Win32Window ** win32_container_window_get_children (Win32Container *self, size_t *length );
 void           win32_container_set_layout  (Win32Container *self, Win32Layout *layout);
 Win32Layout *  win32_container_get_layout  (Win32Container *self);
+void           win32_container_set_realization (Win32Container *self, guint realization);
+guint          win32_container_get_realization (Win32Container *self);
 
 /* INTERNAL */
 void win32_container_add_child (Win32Container *self, Win32Window *child);
+BOOL win32_container_child_needs_realize (Win32Container *self, Win32Window *child);
 
 GType win32_container_get_type (void) G_GNUC_CONST;
 Win32Container* win32_container_construct (GType object_type);
@@ -8,7 +8,6 @@
 
 static gpointer win32_control_parent_class = NULL;
 
-static void creation_callback ( Win32Event *event, void *boundData );
 static void win32_control_finalize (Win32Window * obj);
 static GType win32_control_get_type_once (void);
 
@@ -25,20 +24,16 @@ Win32Control* win32_control_construct (GType object_type,
     Win32Window * window = (Win32Window*) self;
 
     window->parent = parent;
+    self->create_window = create_window;
 
     if ( text != NULL ){
         window->text  = _strdup (text);
     }
 
-    if ( parent->hwnd != NULL ){
-        create_window ((Win32Window*) self, parent);
-    } else {
-        // postpone control creation until parent window is constructed
-        Win32CreationData *data = malloc( sizeof(Win32CreationData) );
-        data->create_window = create_window;
-        data->control = self;
-        win32_window_insert_into_callback_queue( parent, WM_CREATE, creation_callback, data, NULL );
-    }
+    // Otherwise the control is created along with its siblings when the parent is,
+    // or by a lazy parent once it is shown inside the client area
+    if ( parent->hwnd != NULL && win32_container_child_needs_realize ((Win32Container*) parent, window) )
+        win32_control_realize (self, win32_get_default_gui_font());
 
     win32_container_add_child ((Win32Container*) parent, (Win32Window*) self);
 
@@ -46,31 +41,70 @@ Win32Control* win32_control_construct (GType object_type,
 }
 
 
-/* INTERNAL DELAYED CREATION
+/* INTERNAL REALIZE
 ------------------------------------------- */
-void creation_callback ( Win32Event *event, void *boundData )
+// Creates the native control inside the parent window. The window is attached
+// to the HWND on WM_NCCREATE, see the superclass.
+void win32_control_realize (Win32Control *control, HFONT font)
 {
-    Win32CreationData * data = (Win32CreationData*) boundData;
-    Win32WindowCreator create_window = data->create_window;
-    Win32Control *control = data->control;
     Win32Window *window = (Win32Window*) control;
 
-    // window->hwnd is assigned to hwnd inside the create_window function;
-    HWND hwnd = create_window ((Win32Window*) control, event->source );
+    if ( window->hwnd != NULL || control->create_window == NULL ) return;
+
+    // The creators apply the default sizes, a recreated control gets its old place back
+    RECT bounds = { window->left, window->top, window->width, window->height };
+
+    HWND hwnd = control->create_window (window, window->parent);
+    if ( hwnd == NULL ) return;
 
-    // Disable control
+    if ( control->realized ){
+        window->left   = bounds.left;
+        window->top    = bounds.top;
+        window->width  = bounds.right;
+        window->height = bounds.bottom;
+        WIN32_COUNT_CALL (WIN32_CALL_SET_WINDOW_POS);
+        SetWindowPos( hwnd, NULL, window->left, window->top, window->width, window->height,
+                      SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOREDRAW );
+    }
+    control->realized = TRUE;
+
+    // Disable or hide control
     if (!window->enabled) EnableWindow(hwnd, FALSE);
+    if (!window->visible) ShowWindow(hwnd, SW_HIDE);
+
+    // Change the font used to the default gui font, the parent is redrawn anyway
+    SendMessage(hwnd, WM_SETFONT, (WPARAM) font, FALSE);
+
+    // Controls sized by their contents are measured once they have the font
+    if ( window->auto_resize ){
+        Win32WideString text;
+        win32_wide_string_init( &text, window->text );
+        WIN32_WINDOW_GET_CLASS (window)->auto_resize (window, text.str);
+        win32_wide_string_release( &text );
+    }
+}
+
+
+/* INTERNAL UNREALIZE
+------------------------------------------- */
+// Destroys the native control, the window keeps its state and listeners and is
+// realized again later
+void win32_control_unrealize (Win32Control *control)
+{
+    Win32Window *window = (Win32Window*) control;
+    if ( window->hwnd == NULL ) return;
 
-    // Change the font used to the default gui font
-    HFONT defaultFont = win32_get_default_gui_font();
-    SendMessage(hwnd, WM_SETFONT, (LPARAM) defaultFont, TRUE);
+    // Keep what the user changed
+    win32_window_get_text (window);
+    win32_window_get_enabled (window);
+    win32_window_flush_coalesced (window);
 
-    // by the time we override the control procedure,
-    // the WM_NCCREATE message has already been processed.
-    SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR) window );
+    window->unrealizing = TRUE;
+    DestroyWindow (window->hwnd);
+    window->unrealizing = FALSE;
 
-    // release CreationData
-    free (data);
+    window->hwnd = NULL;
+    window->attachedEvents.sizing = FALSE;
 }
 
 
@@ -139,6 +173,37 @@ GType win32_control_get_type (void)
 }
 
 
+/* UTILITY SUPERCLASS
+------------------------------------------- */
+// Registers a window class that behaves like the system class baseClass but
+// delivers its messages to procedure, from WM_NCCREATE on. Controls register
+// their class once and pass the messages they don't stop on to the returned
+// procedure of the base class. Returns NULL on failure.
+WNDPROC win32_control_register_superclass (const wchar_t *baseClass, const wchar_t *className, WNDPROC procedure)
+{
+    WNDCLASSEX wndclass;
+    HINSTANCE hInstance = GetModuleHandle(NULL);
+
+    wndclass.cbSize = sizeof(WNDCLASSEX);
+    if ( !GetClassInfoEx( NULL, baseClass, &wndclass) ) return NULL;
+
+    WNDPROC baseProc = wndclass.lpfnWndProc;
+
+    // Check if the class is already registered in a previous call
+    WNDCLASSEX existing;
+    existing.cbSize = sizeof(WNDCLASSEX);
+    if ( GetClassInfoEx( hInstance, className, &existing) ) return baseProc;
+
+    wndclass.style        &= ~CS_GLOBALCLASS;
+    wndclass.lpfnWndProc   = procedure;
+    wndclass.hInstance     = hInstance;
+    wndclass.lpszClassName = className;
+
+    if ( !RegisterClassEx(&wndclass) ) return NULL;
+    return baseProc;
+}
+
+
 /* UTILITY
 ------------------------------------------- */
 unsigned int win32_control_generate_ID(void){
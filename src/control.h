@@ -14,7 +14,6 @@
 #define ALIGN_CENTER    1
 #define ALIGN_RIGHT     2
 
-typedef struct _Win32CreationData Win32CreationData;
 typedef HWND (*Win32WindowCreator) ( Win32Window *child, Win32Window *parent );
 
 typedef struct _Win32Control Win32Control;
@@ -31,15 +30,11 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC (Win32Control, win32_window_unref)
 
 /* CLASS Control
 ------------------------------------------- */
-struct _Win32CreationData {
-    int ref_count; // not used, just for padding
-    Win32WindowCreator create_window;
-    Win32Control * control;
-};
-
 struct _Win32Control {
     Win32Window parent_instance;
     UINT id;
+    Win32WindowCreator create_window;  // creates the native control once the parent has an HWND
+    BOOL realized;                     // had an HWND before, its geometry is restored on creation
 };
 
 struct _Win32ControlClass {
@@ -48,6 +43,9 @@ struct _Win32ControlClass {
 
 /* INTERNAL */
 unsigned int win32_control_generate_ID (void);
+void win32_control_realize   (Win32Control *control, HFONT font);
+void win32_control_unrealize (Win32Control *control);
+WNDPROC win32_control_register_superclass (const wchar_t *baseClass, const wchar_t *className, WNDPROC procedure);
 Win32Control *win32_control_create( Win32Control *control, Win32Window* parent, Win32WindowCreator create_function, const char *text);
 
 GType win32_control_get_type (void) G_GNUC_CONST;
@@ -8,8 +8,8 @@
 
 void win32_device_context_text_out(HDC hdc, int x, int y, const char * text)
 {
-    wchar_t* _text = fromUTF8( text );
-    size_t length = wcslen( _text );
-    TextOut( hdc, x, y, _text, length );
-    free (_text);
+    Win32WideString _text;
+    win32_wide_string_init( &_text, text );
+    TextOut( hdc, x, y, _text.str, _text.length );
+    win32_wide_string_release( &_text );
 }
@@ -0,0 +1,66 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+static const wchar_t *szClassName = L"Win32Dispatcher";
+static GPrivate g_dispatcher = G_PRIVATE_INIT (NULL);
+
+static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
+
+/* METHOD GET
+------------------------------------------- */
+Win32Dispatcher* win32_dispatcher_get (void)
+{
+    Win32Dispatcher *self = g_private_get (&g_dispatcher);
+    if ( self != NULL ) return self;
+
+    WNDCLASSEX wndclass;
+    HINSTANCE hInstance = GetModuleHandle(NULL);
+
+    // Check if the class is already registered by another thread
+    if ( !GetClassInfoEx( hInstance, szClassName, &wndclass) ){
+        memset( &wndclass, 0, sizeof(WNDCLASSEX) );
+        wndclass.cbSize        = sizeof(WNDCLASSEX);
+        wndclass.lpfnWndProc   = WndProc;
+        wndclass.hInstance     = hInstance;
+        wndclass.lpszClassName = szClassName;
+        RegisterClassEx(&wndclass);
+    }
+
+    self = malloc( sizeof(Win32Dispatcher) );
+    self->thread = GetCurrentThreadId ();
+    win32_invoke_queue_init (&self->queue);
+    self->hwnd = CreateWindowEx (0, szClassName, NULL, 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, hInstance, NULL);
+
+    if ( self->hwnd == NULL ){
+        MessageBox(NULL, L"Dispatcher Creation Failed!", L"Error!", MB_ICONEXCLAMATION | MB_OK);
+        exit (1);  //exit
+    }
+    g_private_set (&g_dispatcher, self);
+    return self;
+}
+
+
+/* INTERNAL WINDOW PROCEDURE
+------------------------------------------- */
+static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    WIN32_PROFILE_BEGIN (start);
+
+    if ( msg == FM_INVOKE ){
+        Win32Dispatcher *self = g_private_get (&g_dispatcher);
+        win32_invoke_drain (self);
+        return WIN32_PROFILE_MESSAGE (msg, start, 0);
+    }
+    if ( msg == win32_task_message && msg != 0 ){
+        // Completion or progress of a task posted by a worker thread
+        win32_task_deliver (wParam, lParam);
+        return WIN32_PROFILE_MESSAGE (msg, start, 0);
+    }
+
+    return WIN32_PROFILE_MESSAGE (msg, start, DefWindowProc(hwnd, msg, wParam, lParam));
+}
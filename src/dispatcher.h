@@ -0,0 +1,28 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_DISPATCHER_H
+#define WIN32_DISPATCHER_H
+
+#include <windows.h>
+#include <glib.h>
+
+/* STRUCT Dispatcher
+------------------------------------------- */
+// A message-only window owned by a UI thread. Other threads post to it rather
+// than to a control, whose HWND may be destroyed or recreated while the message
+// waits in the queue, which would discard it. Created on the first use on the
+// thread, the window lives until the thread exits; the struct is never freed so
+// that posting to a finished thread fails instead of touching freed memory.
+struct _Win32Dispatcher {
+    HWND hwnd;
+    DWORD thread;
+    Win32InvokeQueue queue;    // invocations for the windows of the thread
+};
+
+// The dispatcher of the calling thread
+Win32Dispatcher* win32_dispatcher_get (void);
+
+#endif
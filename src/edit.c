@@ -6,7 +6,8 @@
 #include "vala-win32.h"
 #include <stdio.h>
 
-static WNDPROC g_controlProc = NULL;
+static const wchar_t *szClassName = L"Win32Edit";
+static WNDPROC g_baseProc = NULL;  // procedure of the system class, see the superclass
 static gpointer win32_edit_parent_class = NULL;
 
 static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -54,7 +55,8 @@ HWND win32_edit_create (Win32Window *self, Win32Window *parent)
     Win32Edit    *edit    = (Win32Edit* ) self;
 
     control->id = win32_control_generate_ID ();
-    wchar_t *text = fromUTF8(window->text);
+    Win32WideString text;
+    win32_wide_string_init( &text, window->text );
 
     DWORD styles; // Default is SS_LEFT = 0
     switch (edit->text_align){
@@ -83,8 +85,8 @@ HWND win32_edit_create (Win32Window *self, Win32Window *parent)
     // Creating the Window
     hwnd = CreateWindowEx(
         WS_EX_CLIENTEDGE,
-        L"EDIT",
-        text,
+        szClassName,
+        text.str,
         // Control Styles:
         WS_TABSTOP | WS_VISIBLE | WS_CHILD | styles,
         window->left,   // x position
@@ -94,13 +96,11 @@ HWND win32_edit_create (Win32Window *self, Win32Window *parent)
         parent->hwnd,   // Parent window
         (HANDLE) control->id, // Control ID
         window->hInstance,
-        NULL );
+        window );
 
-    window->hwnd = hwnd;
+    // window->hwnd is assigned on WM_NCCREATE
 
-    g_controlProc = (WNDPROC) SetWindowLongPtr( hwnd, GWLP_WNDPROC, (LONG_PTR) WndProc );
-
-    free(text);
+    win32_wide_string_release( &text );
 
     return hwnd;
 }
@@ -185,11 +185,12 @@ BOOL win32_edit_get_readonly (Win32Edit *instance)
 // the Window Procedure
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    WIN32_PROFILE_BEGIN (start);
     LRESULT result;
     result = win32_window_default_procedure(hwnd, msg, wParam, lParam);
-    if ( result == STOP_PROPAGATION ) return 0;
+    if ( result == STOP_PROPAGATION ) return WIN32_PROFILE_MESSAGE (msg, start, 0);
 
-    return CallWindowProc( g_controlProc, hwnd, msg, wParam, lParam);
+    return WIN32_PROFILE_MESSAGE (msg, start, CallWindowProc( g_baseProc, hwnd, msg, wParam, lParam));
 }
 
 /* INTERNAL GTYPE
@@ -198,6 +199,13 @@ static void win32_edit_class_init (Win32EditClass * klass, gpointer klass_data)
 {
     win32_edit_parent_class = g_type_class_peek_parent (klass);
     ((Win32WindowClass *) klass)->finalize = win32_edit_finalize;
+
+    // Register the superclass once, every edit shares it
+    g_baseProc = win32_control_register_superclass( L"EDIT", szClassName, WndProc );
+    if ( g_baseProc == NULL ){
+        MessageBox(NULL, L"Window Registration Failed!", L"Error!", MB_ICONEXCLAMATION | MB_OK);
+        exit (1); // exit
+    }
 }
 
 static void win32_edit_instance_init (Win32Edit * self, gpointer klass)
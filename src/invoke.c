@@ -0,0 +1,131 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+
+/* INTERNAL CONSTRUCTOR
+------------------------------------------- */
+// Every UI thread has its own queue, kept by its dispatcher
+void win32_invoke_queue_init (Win32InvokeQueue *queue)
+{
+    memset( queue, 0, sizeof(Win32InvokeQueue) );
+    queue->head = &queue->stub;
+    queue->tail = &queue->stub;
+}
+
+
+/* INTERNAL PUSH
+------------------------------------------- */
+static void win32_invoke_queue_push (Win32InvokeQueue *queue, Win32Invocation *node)
+{
+    node->next = NULL;
+    Win32Invocation *previous = InterlockedExchangePointer ((void* volatile*) &queue->head, node);
+    // Until the link below is made, the consumer sees the queue as busy
+    InterlockedExchangePointer ((void* volatile*) &previous->next, node);
+}
+
+
+/* INTERNAL POP
+------------------------------------------- */
+// Returns NULL when the queue is empty, or while a producer is between the
+// two steps of a push
+static Win32Invocation* win32_invoke_queue_pop (Win32InvokeQueue *queue)
+{
+    Win32Invocation *tail = queue->tail;
+    Win32Invocation *next = tail->next;
+
+    // Skip the stub
+    if ( tail == &queue->stub ){
+        if ( next == NULL ) return NULL;
+        queue->tail = next;
+        tail = next;
+        next = next->next;
+    }
+    if ( next != NULL ){
+        queue->tail = next;
+        return tail;
+    }
+    if ( tail != queue->head ) return NULL;
+
+    // The last node can only be taken with the stub behind it
+    win32_invoke_queue_push (queue, &queue->stub);
+    next = tail->next;
+    if ( next != NULL ){
+        queue->tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+
+/* INTERNAL EMPTY
+------------------------------------------- */
+static BOOL win32_invoke_queue_empty (Win32InvokeQueue *queue)
+{
+    return queue->tail == &queue->stub && queue->head == &queue->stub;
+}
+
+
+/* INTERNAL WAKE
+------------------------------------------- */
+// Posts a single wake-up for however many invocations are queued. The
+// dispatcher's window lives as long as its thread, so the wake-up isn't lost
+// to a control being destroyed; it only fails once the thread is gone.
+static void win32_invoke_wake (Win32Dispatcher *dispatcher)
+{
+    if ( !g_atomic_int_compare_and_exchange (&dispatcher->queue.wakePending, 0, 1) ) return;
+
+    if ( !PostMessage (dispatcher->hwnd, FM_INVOKE, 0, 0) ) g_atomic_int_set (&dispatcher->queue.wakePending, 0);
+}
+
+
+/* METHOD INVOKE ASYNC
+------------------------------------------- */
+void win32_window_invoke_async (Win32Window *window,
+                                Win32InvokeFunction function,
+                                void *boundData,
+                                Win32ReleaseFunction releaseData)
+{
+    Win32Invocation *node = malloc( sizeof(Win32Invocation) );
+    if ( node == NULL ) return;
+
+    node->window = win32_window_ref (window);
+    node->function = function;
+    node->boundData = boundData;
+    node->releaseData = releaseData;
+
+    // The dispatcher is set when the window is constructed, no other field of the
+    // window is read from this thread
+    win32_invoke_queue_push (&window->dispatcher->queue, node);
+    win32_invoke_wake (window->dispatcher);
+}
+
+
+/* INTERNAL DRAIN
+------------------------------------------- */
+// Runs the queued invocations on a wake-up, from the dispatcher. The queue only
+// holds invocations for the windows of the calling thread.
+void win32_invoke_drain (Win32Dispatcher *dispatcher)
+{
+    Win32InvokeQueue *queue = &dispatcher->queue;
+
+    // Cleared first, what is pushed from here on is either run in this batch
+    // or wakes the thread again
+    g_atomic_int_set (&queue->wakePending, 0);
+
+    for (int n=0; n<INVOKE_BATCH_SIZE; n++){
+        Win32Invocation *node = win32_invoke_queue_pop (queue);
+        if ( node == NULL ) break;
+
+        node->function (node->window, node->boundData);
+        if ( node->releaseData != NULL ) node->releaseData (node->boundData);
+        win32_window_unref (node->window);
+        free (node);
+    }
+
+    // A full batch, or a push that was halfway through
+    if ( !win32_invoke_queue_empty (queue) ) win32_invoke_wake (dispatcher);
+}
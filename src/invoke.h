@@ -0,0 +1,49 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_INVOKE_H
+#define WIN32_INVOKE_H
+
+#include <windows.h>
+#include <glib.h>
+
+#define INVOKE_BATCH_SIZE  4096   // invocations run per wake-up, the rest wait for the next one
+
+typedef void (*Win32InvokeFunction) (Win32Window *window, void *boundData);
+
+/* STRUCT Invocation
+------------------------------------------- */
+typedef struct _Win32Invocation {
+    struct _Win32Invocation * volatile next;
+    Win32Window *window;
+    Win32InvokeFunction function;
+    void *boundData;
+    Win32ReleaseFunction releaseData;
+} Win32Invocation;
+
+/* STRUCT InvokeQueue
+------------------------------------------- */
+// Intrusive multi-producer single-consumer queue. Any thread pushes with a
+// single exchange, the UI thread pops without locking. The stub node keeps
+// the queue from ever being empty.
+typedef struct _Win32InvokeQueue {
+    Win32Invocation * volatile head;    // the last node pushed, producers swap themselves in
+    Win32Invocation *tail;              // the next node to pop, consumer only
+    Win32Invocation stub;
+    volatile int wakePending;           // a wake-up message is on its way
+} Win32InvokeQueue;
+
+// Runs the function with the window on the thread the window belongs to, from
+// any thread. The invocations of every thread are run in the order they were queued.
+void win32_window_invoke_async (Win32Window *window,
+                                Win32InvokeFunction function,
+                                void *boundData,
+                                Win32ReleaseFunction releaseData);
+
+/* INTERNAL */
+void win32_invoke_queue_init (Win32InvokeQueue *queue);
+void win32_invoke_drain (Win32Dispatcher *dispatcher);
+
+#endif
@@ -6,7 +6,8 @@
 #include "vala-win32.h"
 #include <stdio.h>
 
-static WNDPROC g_controlProc = NULL;
+static const wchar_t *szClassName = L"Win32Label";
+static WNDPROC g_baseProc = NULL;  // procedure of the system class, see the superclass
 static gpointer win32_label_parent_class = NULL;
 
 static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -41,7 +42,8 @@ HWND win32_label_create (Win32Window *self, Win32Window *parent)
     Win32Label   *label   = (Win32Label* ) self;
 
     control->id = win32_control_generate_ID();
-    wchar_t *text = fromUTF8(window->text);
+    Win32WideString text;
+    win32_wide_string_init( &text, window->text );
 
     DWORD style; // Default is SS_LEFT = 0
     switch (label->text_align){
@@ -62,8 +64,8 @@ HWND win32_label_create (Win32Window *self, Win32Window *parent)
 
     // Creating the Window
     hwnd = CreateWindow(
-        L"STATIC",
-        text,
+        szClassName,
+        text.str,
         // Control Styles:
         WS_VISIBLE | WS_CHILD | SS_NOPREFIX | style,
         window->left,   // x position
@@ -73,16 +75,12 @@ HWND win32_label_create (Win32Window *self, Win32Window *parent)
         parent->hwnd,   // Parent window
         (HANDLE) control->id, // Control ID
         window->hInstance,
-        NULL );
+        window );
 
-    window->hwnd = hwnd;
+    // window->hwnd is assigned on WM_NCCREATE
+    // The label is resized to fit its text once it has its font, see win32_control_realize
 
-    g_controlProc = (WNDPROC) SetWindowLongPtr( hwnd, GWLP_WNDPROC, (LONG_PTR) WndProc );
-
-    // resize to fit the contents of the label
-    win32_label_auto_resize (window, text);
-
-    free (text);
+    win32_wide_string_release( &text );
 
     return hwnd;
 }
@@ -144,13 +142,11 @@ void win32_label_auto_resize (Win32Window *window, const void *data)
     if (!window->hwnd) return;
 
     SIZE size;
-    wchar_t *text = (wchar_t*) data;
-    int length = lstrlen(text);
+    const wchar_t *text = (const wchar_t*) data;
+    // an empty label keeps a usable size
+    if ( text == NULL || text[0] == 0 ) text = L"Dummy";
 
-    HDC context = GetDC(window->hwnd);
-    if ( length == 0 ) GetTextExtentPoint32 (context, L"Dummy", 5, &size );
-    else GetTextExtentPoint32 (context, text, length, &size );
-    ReleaseDC (window->hwnd, context);
+    if ( !win32_text_metrics_measure_window (window, text, &size) ) return;
 
     if (window->pref_width)  size.cx = window->pref_width;
     if (window->pref_height) size.cy = window->pref_height;
@@ -158,7 +154,8 @@ void win32_label_auto_resize (Win32Window *window, const void *data)
     window->width = size.cx;
     window->height = size.cy;
 
-    win32_window_resize (window, size.cx, size.cy);
+    // the siblings anchored to the label have to follow it
+    if ( !win32_window_update_layout (window) ) win32_window_resize (window, size.cx, size.cy);
 }
 
 
@@ -168,11 +165,12 @@ void win32_label_auto_resize (Win32Window *window, const void *data)
 // the Window Procedure
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    WIN32_PROFILE_BEGIN (start);
     LRESULT result;
     result = win32_window_default_procedure(hwnd, msg, wParam, lParam);
-    if ( result == STOP_PROPAGATION ) return 0;
+    if ( result == STOP_PROPAGATION ) return WIN32_PROFILE_MESSAGE (msg, start, 0);
 
-    return CallWindowProc( g_controlProc, hwnd, msg, wParam, lParam);
+    return WIN32_PROFILE_MESSAGE (msg, start, CallWindowProc( g_baseProc, hwnd, msg, wParam, lParam));
 }
 
 
@@ -183,6 +181,13 @@ static void win32_label_class_init (Win32LabelClass * klass, gpointer klass_data
     win32_label_parent_class = g_type_class_peek_parent (klass);
     ((Win32WindowClass *) klass)->finalize = win32_label_finalize;
     ((Win32WindowClass *) klass)->auto_resize = win32_label_auto_resize;
+
+    // Register the superclass once, every label shares it
+    g_baseProc = win32_control_register_superclass( L"STATIC", szClassName, WndProc );
+    if ( g_baseProc == NULL ){
+        MessageBox(NULL, L"Window Registration Failed!", L"Error!", MB_ICONEXCLAMATION | MB_OK);
+        exit (1); // exit
+    }
 }
 
 static void win32_label_instance_init (Win32Label * self, gpointer klass)
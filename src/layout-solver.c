@@ -0,0 +1,391 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "layout-solver.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void win32_layout_recorder_begin (Win32LayoutSink *sink, size_t numItems);
+static void win32_layout_recorder_place (Win32LayoutSink *sink, size_t index, int left, int top, int width, int height);
+static void win32_layout_recorder_end   (Win32LayoutSink *sink);
+
+/* CONSTRUCTOR
+------------------------------------------- */
+void win32_layout_solver_init (Win32LayoutSolver *solver)
+{
+    memset( solver, 0, sizeof(Win32LayoutSolver) );
+    solver->fullPass = 1;
+}
+
+
+/* CLEANUP
+------------------------------------------- */
+void win32_layout_solver_clear (Win32LayoutSolver *solver)
+{
+    free (solver->items);
+    free (solver->queue);
+    free (solver->dependency);
+    free (solver->firstDependent);
+    free (solver->dependents);
+    free (solver->order);
+    free (solver->changed);
+    win32_layout_solver_init (solver);
+}
+
+
+/* METHOD SET SIZE
+------------------------------------------- */
+// Returns the item array to be filled in by the caller. The contents of the
+// items are preserved, newly added ones are zeroed.
+Win32LayoutItem *win32_layout_solver_set_size (Win32LayoutSolver *solver, size_t numItems)
+{
+    if ( numItems > solver->itemCapacity ){
+        solver->items = realloc( solver->items, sizeof(Win32LayoutItem) * numItems );
+        memset( solver->items + solver->itemCapacity, 0, sizeof(Win32LayoutItem) * (numItems - solver->itemCapacity) );
+        solver->queue = realloc( solver->queue, sizeof(size_t) * numItems );
+        solver->itemCapacity = numItems;
+    }
+    solver->numItems = numItems;
+    return solver->items;
+}
+
+
+/* UTILITY
+------------------------------------------- */
+int win32_edge_to_index (int edge)
+{
+    switch (edge){
+        case EDGE_LEFT:   return 0;
+        case EDGE_TOP:    return 1;
+        case EDGE_RIGHT:  return 2;
+        case EDGE_BOTTOM: return 3;
+    }
+    return -1;
+}
+
+
+/* INTERNAL PLAN UTILITY
+------------------------------------------- */
+// Find out which edge the given edge of the item is calculated from
+static size_t win32_layout_solver_find_dependency (Win32LayoutSolver *solver, size_t node)
+{
+    size_t index = node / 4;
+    int n = node % 4;
+    int pair = (n + 2) % 4;  // LEFT-RIGHT and TOP-BOTTOM edges are considered pairs
+    Win32LayoutAnchorSpec *anchor = &solver->items[index].anchors[n];
+
+    switch (anchor->kind){
+        case LAYOUT_ANCHOR_NONE:
+            // The right (bottom) edge always follows the left (top) one, the left (top)
+            // edge follows the right (bottom) one only if the latter is anchored.
+            if ( n >= 2 || solver->items[index].anchors[pair].kind != LAYOUT_ANCHOR_NONE )
+                return index * 4 + pair;
+            return EDGE_NO_DEPENDENCY;
+
+        case LAYOUT_ANCHOR_SIBLING:
+            if ( anchor->sibling >= solver->numItems || win32_edge_to_index (anchor->edge) < 0 )
+                return EDGE_NO_DEPENDENCY;
+            return anchor->sibling * 4 + win32_edge_to_index (anchor->edge);
+    }
+    // Anchored to the parent
+    return EDGE_NO_DEPENDENCY;
+}
+
+
+/* INTERNAL PLAN UTILITY
+------------------------------------------- */
+static void win32_layout_solver_reserve (Win32LayoutSolver *solver, size_t numNodes)
+{
+    solver->orderLength = 0;
+    // Reuse the buffers of the previous plan whenever possible
+    if ( numNodes <= solver->nodeCapacity ) return;
+
+    free (solver->dependency);
+    free (solver->firstDependent);
+    free (solver->dependents);
+    free (solver->order);
+    free (solver->changed);
+
+    solver->dependency     = malloc( sizeof(size_t) * numNodes );
+    solver->firstDependent = malloc( sizeof(size_t) * (numNodes + 1) );
+    solver->dependents     = malloc( sizeof(size_t) * numNodes );
+    solver->order          = malloc( sizeof(size_t) * numNodes );
+    solver->changed        = malloc( sizeof(int) * numNodes );
+    solver->nodeCapacity = numNodes;
+}
+
+
+/* METHOD PLAN
+------------------------------------------- */
+// Builds the dependency graph of the edges and sorts it topologically so that
+// every edge comes after the edge it is calculated from: O(V + E)
+void win32_layout_solver_plan (Win32LayoutSolver *solver)
+{
+    size_t numNodes = solver->numItems * 4;
+
+    win32_layout_solver_reserve (solver, numNodes);
+    solver->fullPass = 1;
+    if ( numNodes == 0 ) return;
+
+    // Find the dependency of each edge and count the dependents
+    size_t *firstDependent = solver->firstDependent;
+    memset( firstDependent, 0, sizeof(size_t) * (numNodes + 1) );
+
+    size_t node, dependency;
+    for (node=0; node<numNodes; node++)
+    {
+        dependency = win32_layout_solver_find_dependency (solver, node);
+        solver->dependency[node] = dependency;
+        if ( dependency != EDGE_NO_DEPENDENCY ) firstDependent[dependency + 1] += 1;
+    }
+    for (node=0; node<numNodes; node++) firstDependent[node + 1] += firstDependent[node];
+
+    // Fill in the arcs; firstDependent[i] is used as the insertion point of node i
+    // and ends up at the start of node i+1, hence the shift afterwards
+    size_t *dependents = solver->dependents;
+    for (node=0; node<numNodes; node++){
+        dependency = solver->dependency[node];
+        if ( dependency != EDGE_NO_DEPENDENCY ) dependents[ firstDependent[dependency]++ ] = node;
+    }
+    for (node=numNodes; node>0; node--) firstDependent[node] = firstDependent[node - 1];
+    firstDependent[0] = 0;
+
+    // Every edge has a single dependency at most, so an edge is ready as soon as
+    // the edge it depends on is placed: the order doubles as the BFS queue.
+    size_t *order = solver->order;
+    for (node=0; node<numNodes; node++){
+        if ( solver->dependency[node] == EDGE_NO_DEPENDENCY ) order[solver->orderLength++] = node;
+    }
+
+    for (size_t head=0; head<solver->orderLength; head++)
+    {
+        node = order[head];
+        for (size_t arc=firstDependent[node]; arc<firstDependent[node + 1]; arc++){
+            order[solver->orderLength++] = dependents[arc];
+        }
+    }
+
+    // Circular anchors can not be resolved, the edges involved are left out
+    // of the plan and keep their previous positions.
+}
+
+
+/* INTERNAL SOLVE UTILITY
+------------------------------------------- */
+static int win32_layout_solver_calculate (Win32LayoutSolver *solver, const Win32LayoutMetrics *metrics,
+                                          Win32LayoutItem *item, int n, int containerWidth, int containerHeight)
+{
+    double scale = (double) metrics->scale;
+    int halfSpacing_L = metrics->vSpacing / 2 + (metrics->vSpacing % 2);
+    int halfSpacing_R = metrics->vSpacing / 2;
+    int halfSpacing_T = metrics->hSpacing / 2 + (metrics->hSpacing % 2);
+    int halfSpacing_B = metrics->hSpacing / 2;
+
+    Win32LayoutAnchorSpec *anchor = &item->anchors[n];
+    Win32LayoutItem *reference = NULL;
+
+    if ( anchor->kind == LAYOUT_ANCHOR_SIBLING && anchor->sibling < solver->numItems )
+        reference = &solver->items[anchor->sibling];
+
+    switch ( n )
+    {
+    case 0: // LEFT
+        // Positioning relative to a sibling
+        if ( reference ){
+            if ( anchor->edge == EDGE_RIGHT ) return reference->edges[2] + metrics->vSpacing;
+            if ( anchor->edge == EDGE_LEFT )  return reference->edges[0];
+            break;
+        }
+        // Positioning relative to the parent
+        if ( anchor->kind == LAYOUT_ANCHOR_PARENT ) return (int) (anchor->ratio / scale * containerWidth) + halfSpacing_R;
+        // No anchor is provided
+        if ( item->anchors[2].kind != LAYOUT_ANCHOR_NONE ) return item->edges[2] - item->width;
+        return halfSpacing_R; // 0
+
+    case 1: // TOP
+        if ( reference ){
+            if ( anchor->edge == EDGE_BOTTOM ) return reference->edges[3] + metrics->hSpacing;
+            if ( anchor->edge == EDGE_TOP )    return reference->edges[1];
+            break;
+        }
+        if ( anchor->kind == LAYOUT_ANCHOR_PARENT ) return (int) (anchor->ratio / scale * containerHeight) + halfSpacing_B;
+        if ( item->anchors[3].kind != LAYOUT_ANCHOR_NONE ) return item->edges[3] - item->height;
+        return halfSpacing_B; // 0
+
+    case 2: // RIGHT
+        if ( reference ){
+            if ( anchor->edge == EDGE_RIGHT ) return reference->edges[2];
+            if ( anchor->edge == EDGE_LEFT )  return reference->edges[0] - metrics->vSpacing;
+            break;
+        }
+        if ( anchor->kind == LAYOUT_ANCHOR_PARENT ) return (int) (anchor->ratio / scale * containerWidth) - halfSpacing_L;
+        return item->edges[0] + item->width;
+
+    case 3: // BOTTOM
+        if ( reference ){
+            if ( anchor->edge == EDGE_BOTTOM ) return reference->edges[3];
+            if ( anchor->edge == EDGE_TOP )    return reference->edges[1] - metrics->hSpacing;
+            break;
+        }
+        if ( anchor->kind == LAYOUT_ANCHOR_PARENT ) return (int) (anchor->ratio / scale * containerHeight) - halfSpacing_T;
+        return item->edges[1] + item->height;
+    }
+    // Anchored to an edge of the other axis
+    return item->edges[n];
+}
+
+
+/* METHOD SOLVE
+------------------------------------------- */
+// Only the edges marked dirty and the ones downstream of a changed edge are
+// recalculated. Only the items with a recalculated edge are handed over to the
+// sink, every item after a full pass; the sink is expected to skip the
+// rectangles it has already applied.
+void win32_layout_solver_solve (Win32LayoutSolver *solver, const Win32LayoutMetrics *metrics,
+                                int clientWidth, int clientHeight, Win32LayoutSink *sink)
+{
+    // Every edge depends on the size of the container, directly or indirectly
+    if ( clientWidth != solver->clientWidth || clientHeight != solver->clientHeight ){
+        solver->clientWidth  = clientWidth;
+        solver->clientHeight = clientHeight;
+        solver->fullPass = 1;
+    }
+    int containerWidth  = clientWidth - 2 * metrics->vPadding + metrics->vSpacing;
+    int containerHeight = clientHeight - 2 * metrics->hPadding + metrics->hSpacing;
+    int fullPass = solver->fullPass;
+    solver->queueLength = 0;
+
+    Win32LayoutItem *item;
+    size_t node, dependency;
+    int n, edge, value;
+    for (size_t i=0; i<solver->orderLength; i++)
+    {
+        node = solver->order[i];
+        item = &solver->items[node / 4];
+        n    = node % 4;
+        edge = 1 << n;
+        dependency = solver->dependency[node];
+
+        if ( !fullPass && !(item->dirty & edge) && !item->anchors[n].dirty &&
+             !(dependency != EDGE_NO_DEPENDENCY && solver->changed[dependency]) ){
+            solver->changed[node] = 0;
+            continue;
+        }
+
+        value = win32_layout_solver_calculate (solver, metrics, item, n, containerWidth, containerHeight);
+        solver->changed[node] = fullPass || value != item->edges[n];
+        item->edges[n] = value;
+        item->dirty &= ~edge;
+        item->anchors[n].dirty = 0;
+
+        if ( !fullPass && !item->queued ){
+            item->queued = 1;
+            solver->queue[solver->queueLength++] = node / 4;
+        }
+    }
+    solver->fullPass = 0;
+    if ( fullPass ){
+        for (size_t i=0; i<solver->numItems; i++) solver->queue[i] = i;
+        solver->queueLength = solver->numItems;
+    }
+
+    int halfSpacing_R = metrics->vSpacing / 2;
+    int halfSpacing_B = metrics->hSpacing / 2;
+
+    sink->begin (sink, solver->queueLength);
+    for (size_t i=0; i<solver->queueLength; i++)
+    {
+        size_t index = solver->queue[i];
+        item = &solver->items[index];
+        item->queued = 0;
+        sink->place (sink, index, item->edges[0] + metrics->vPadding - halfSpacing_R,
+                                  item->edges[1] + metrics->hPadding - halfSpacing_B,
+                                  item->edges[2] - item->edges[0], item->edges[3] - item->edges[1]);
+    }
+    sink->end (sink);
+}
+
+
+/*┌────────────────────────────────────────────────────────┐
+  │ LAYOUT RECORDER                                        │
+  └────────────────────────────────────────────────────────┘*/
+
+/* CONSTRUCTOR
+------------------------------------------- */
+void win32_layout_recorder_init (Win32LayoutRecorder *recorder)
+{
+    memset( recorder, 0, sizeof(Win32LayoutRecorder) );
+    recorder->sink.begin = win32_layout_recorder_begin;
+    recorder->sink.place = win32_layout_recorder_place;
+    recorder->sink.end   = win32_layout_recorder_end;
+}
+
+
+/* CLEANUP
+------------------------------------------- */
+void win32_layout_recorder_clear (Win32LayoutRecorder *recorder)
+{
+    free (recorder->rects);
+    win32_layout_recorder_init (recorder);
+}
+
+
+/* INTERNAL SINK
+------------------------------------------- */
+static void win32_layout_recorder_begin (Win32LayoutSink *sink, size_t numItems)
+{
+    Win32LayoutRecorder *recorder = (Win32LayoutRecorder*) sink;
+    (void) numItems;
+    recorder->numPlaced = 0;
+}
+
+
+/* INTERNAL SINK
+------------------------------------------- */
+// Only the recalculated items are handed over, the rectangles grow as indices come in
+static void win32_layout_recorder_reserve (Win32LayoutRecorder *recorder, size_t index)
+{
+    if ( index >= recorder->length ) recorder->length = index + 1;
+    if ( index < recorder->capacity ) return;
+
+    size_t capacity = recorder->capacity * 2;
+    if ( capacity <= index ) capacity = index + 1;
+    recorder->rects = realloc( recorder->rects, sizeof(int[4]) * capacity );
+    // Mark the new rectangles as never placed
+    for (size_t i=recorder->capacity; i<capacity; i++){
+        recorder->rects[i][0] = recorder->rects[i][1] = INT_MIN;
+        recorder->rects[i][2] = recorder->rects[i][3] = -1;
+    }
+    recorder->capacity = capacity;
+}
+
+
+/* INTERNAL SINK
+------------------------------------------- */
+// Counts the rectangles that differ from the recorded ones, which is the
+// number of windows a real sink would move
+static void win32_layout_recorder_place (Win32LayoutSink *sink, size_t index, int left, int top, int width, int height)
+{
+    Win32LayoutRecorder *recorder = (Win32LayoutRecorder*) sink;
+    win32_layout_recorder_reserve (recorder, index);
+    int *rect = recorder->rects[index];
+
+    if ( rect[0] == left && rect[1] == top && rect[2] == width && rect[3] == height ) return;
+
+    rect[0] = left;
+    rect[1] = top;
+    rect[2] = width;
+    rect[3] = height;
+    recorder->numPlaced += 1;
+}
+
+
+/* INTERNAL SINK
+------------------------------------------- */
+static void win32_layout_recorder_end (Win32LayoutSink *sink)
+{
+    (void) sink;
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef _WIN32_LAYOUT_SOLVER_H_
+#define _WIN32_LAYOUT_SOLVER_H_
+
+// The solver is plain C on purpose: it does not depend on the Windows or GLib
+// headers, so it can be built and benchmarked with the native host compiler.
+#include <stddef.h>
+
+#define EDGE_LEFT     1
+#define EDGE_TOP      2
+#define EDGE_RIGHT    4
+#define EDGE_BOTTOM   8
+#define EDGE_ALL      (EDGE_LEFT | EDGE_TOP | EDGE_RIGHT | EDGE_BOTTOM)
+
+#define LAYOUT_ANCHOR_NONE      0
+#define LAYOUT_ANCHOR_PARENT    1
+#define LAYOUT_ANCHOR_SIBLING   2
+
+#define EDGE_NO_DEPENDENCY ((size_t) -1)
+
+/* STRUCT LayoutItem
+------------------------------------------- */
+typedef struct _Win32LayoutAnchorSpec {
+    int kind;            // see LAYOUT_ANCHOR_* constants
+    size_t sibling;      // index of the sibling item
+    int edge;            // edge of the sibling
+    unsigned int ratio;  // position relative to the parent
+    int dirty;
+} Win32LayoutAnchorSpec;
+
+typedef struct _Win32LayoutItem {
+    Win32LayoutAnchorSpec anchors[4];  // left, top, right, bottom
+    int width;                         // size used for the edges without an anchor
+    int height;
+    int edges[4];                      // calculated edges, padding excluded
+    int dirty;                         // edges to be recalculated, see EDGE_* flags
+    int queued;                        // an edge was recalculated, the item goes to the sink
+} Win32LayoutItem;
+
+/* INTERFACE LayoutSink
+------------------------------------------- */
+// Receives the rectangles calculated by the solver. begin is told how many
+// rectangles are about to be placed, the ones that were recalculated.
+typedef struct _Win32LayoutSink Win32LayoutSink;
+
+struct _Win32LayoutSink {
+    void (*begin) (Win32LayoutSink *sink, size_t numItems);
+    void (*place) (Win32LayoutSink *sink, size_t index, int left, int top, int width, int height);
+    void (*end)   (Win32LayoutSink *sink);
+};
+
+/* STRUCT LayoutMetrics
+------------------------------------------- */
+typedef struct _Win32LayoutMetrics {
+    unsigned int vPadding;
+    unsigned int hPadding;
+    unsigned int hSpacing;
+    unsigned int vSpacing;
+    unsigned int scale;
+} Win32LayoutMetrics;
+
+/* CLASS LayoutSolver
+------------------------------------------- */
+// Node (i * 4 + n) of the graph stands for the edge (1 << n) of the i'th item.
+// An edge is calculated from at most one other edge, so the graph is a forest
+// whose arcs point from an edge to the edges depending on it.
+typedef struct _Win32LayoutSolver {
+    Win32LayoutItem *items;
+    size_t numItems;
+    size_t itemCapacity;
+    size_t *queue;           // items handed over to the sink after the pass
+    size_t queueLength;
+    size_t *dependency;      // the node a node is calculated from
+    size_t *firstDependent;  // dependents of node i: dependents[ firstDependent[i] .. firstDependent[i+1] )
+    size_t *dependents;
+    size_t *order;           // nodes in the order they are calculated
+    size_t orderLength;
+    int *changed;            // the value of the node changed during the last pass
+    size_t nodeCapacity;
+    int clientWidth;
+    int clientHeight;
+    int fullPass;            // recalculate every edge in the next pass
+} Win32LayoutSolver;
+
+void win32_layout_solver_init  (Win32LayoutSolver *solver);
+void win32_layout_solver_clear (Win32LayoutSolver *solver);
+
+Win32LayoutItem *win32_layout_solver_set_size (Win32LayoutSolver *solver, size_t numItems);
+void win32_layout_solver_plan  (Win32LayoutSolver *solver);
+void win32_layout_solver_solve (Win32LayoutSolver *solver, const Win32LayoutMetrics *metrics,
+                                int clientWidth, int clientHeight, Win32LayoutSink *sink);
+
+int win32_edge_to_index (int edge);
+
+/* CLASS LayoutRecorder
+------------------------------------------- */
+// Headless sink, records the rectangles instead of moving windows
+typedef struct _Win32LayoutRecorder {
+    Win32LayoutSink sink;
+    int (*rects)[4];  // left, top, width, height
+    size_t length;
+    size_t capacity;
+    size_t numPlaced;
+} Win32LayoutRecorder;
+
+void win32_layout_recorder_init  (Win32LayoutRecorder *recorder);
+void win32_layout_recorder_clear (Win32LayoutRecorder *recorder);
+
+#endif
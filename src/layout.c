@@ -6,10 +6,6 @@
 #include "vala-win32.h"
 #include <stdio.h>
 
-void win32_edge_list_append (Win32EdgeList *list, Win32Window *item, int edge);
-BOOL win32_edge_list_includes (Win32EdgeList *list, Win32Window *item, int edge);
-void win32_edge_list_prepend_referred_edges (Win32EdgeList *list, Win32Window *item, int edge);
-
 /* CONSTRUCTOR
 ------------------------------------------- */
 Win32RelativeLayout* win32_relative_layout_new (UINT padding, UINT spacing)
@@ -23,11 +19,13 @@ Win32RelativeLayout* win32_relative_layout_new (UINT padding, UINT spacing)
 
     layout->recalculate = win32_relative_layout_recalculate;
     layout->configure   = win32_relative_layout_configure;
+    layout->finalize    = win32_relative_layout_finalize;
     relativeLayout->vPadding = padding;
     relativeLayout->hPadding = padding;
     relativeLayout->hSpacing = spacing;
     relativeLayout->vSpacing = spacing;
     relativeLayout->scale = 100;
+    win32_layout_solver_init (&relativeLayout->solver);
 
     return relativeLayout;
 }
@@ -38,6 +36,7 @@ Win32RelativeLayout* win32_relative_layout_new (UINT padding, UINT spacing)
 Win32RelativeLayout* win32_relative_layout_set_scale(Win32RelativeLayout* self, UINT scale)
 {
     self->scale = scale;
+    self->solver.fullPass = TRUE;
     return self;
 }
 
@@ -48,6 +47,7 @@ Win32RelativeLayout* win32_relative_layout_with_spacing(Win32RelativeLayout* sel
 {
     self->vSpacing = vSpacing;
     self->hSpacing = (hSpacing == -1) ? vSpacing : hSpacing;
+    self->solver.fullPass = TRUE;
     return self;
 }
 
@@ -58,92 +58,41 @@ Win32RelativeLayout* win32_relative_layout_with_padding(Win32RelativeLayout* sel
 {
     self->vPadding = vPadding;
     self->hPadding = (hPadding == -1) ? vPadding : hPadding;
+    self->solver.fullPass = TRUE;
     return self;
 }
 
 
-/* INTERNAL LAYOUT SETUP
+/* INTERNAL LAYOUT UTILITY
 ------------------------------------------- */
-void win32_relative_layout_configure(Win32Container* container)
+static Win32Anchor *win32_layout_data_get_anchor (Win32LayoutData *data, int edge)
 {
-    Win32RelativeLayout *layout = (Win32RelativeLayout*) container->layout;
-
-    Win32Window ** children = container->childWindows.items;
-    size_t numChildren      = container->childWindows.length;
-
-    // initialize lists
-    free(layout->edgeList.items); // freeing an empty list (i.e. NULL pointer) is OK
-    layout->edgeList.length = numChildren * 4;
-    layout->edgeList.items = malloc( sizeof(Win32EdgeListItem) * layout->edgeList.length );
-    memset( layout->edgeList.items, 0, sizeof(Win32EdgeListItem) * layout->edgeList.length );
-
-    Win32Window *child;
-    Win32Window *reference;
-    Win32Anchor *anchor, *pair;
-    // Re-arrange children
-    int edge, pairEdge;
-    for (int i=0; i<numChildren; i++)
-    {
-        child = children[i];
-
-        for ( int n=0; n<4; n++) // Four sides of a window
-        {
-            edge = 1 << n;
-            if ( win32_edge_list_includes( &layout->edgeList, child, edge) ) continue;
-
-            win32_edge_list_prepend_referred_edges (&layout->edgeList, child, edge );
-            win32_edge_list_append (&layout->edgeList, child, edge );
-        }// END LOOP
-
-    }// END OUTER LOOP
+    switch (edge){
+        case EDGE_LEFT:   return data->left;
+        case EDGE_TOP:    return data->top;
+        case EDGE_RIGHT:  return data->right;
+        case EDGE_BOTTOM: return data->bottom;
+    }
+    return NULL;
 }
 
 
 /* INTERNAL LAYOUT UTILITY
 ------------------------------------------- */
-void win32_edge_list_prepend_referred_edges(Win32EdgeList *list, Win32Window *item, int edge)
+// Describe the anchor of the given edge of a child to the solver
+static void win32_relative_layout_describe_anchor (Win32Container *container, Win32Anchor *anchor,
+                                                   int edge, Win32LayoutAnchorSpec *spec)
 {
-    Win32Window *child = item;
-    Win32Anchor *anchor, *pair;
-    int pairEdge;
+    spec->kind  = LAYOUT_ANCHOR_NONE;
+    spec->dirty = TRUE;
+    if ( !anchor ) return;
 
-    switch (edge){
-        case EDGE_LEFT:
-            anchor = child->positioning->left;
-            pair   = child->positioning->right;
-            pairEdge = EDGE_RIGHT;
-            break;
-        case EDGE_TOP:
-            anchor = child->positioning->top;
-            pair   = child->positioning->bottom;
-            pairEdge = EDGE_BOTTOM;
-            break;
-        case EDGE_RIGHT:
-            anchor = child->positioning->right;
-            pair   = child->positioning->left;
-            pairEdge = EDGE_LEFT;
-            break;
-        case EDGE_BOTTOM:
-            anchor = child->positioning->bottom;
-            pair   = child->positioning->top;
-            pairEdge = EDGE_TOP;
-            break;
-    }
-    // NULL anchor
-    if ( !anchor ){
-        // LEFT-RIGHT and TOP-BOTTOM edges are considered pairs.
-        // If only one element of a pair is NULL, the calculated value of the
-        // NULL anchor will be dependent upon the non-null pair.
-        if ( pair && !win32_edge_list_includes(list, child, pairEdge) )
-        {
-            win32_edge_list_prepend_referred_edges(list, child, pairEdge);
-            win32_edge_list_append(list, child, pairEdge);
-        }
+    // Anchored to the parent
+    if ( !anchor->reference ){
+        spec->kind  = LAYOUT_ANCHOR_PARENT;
+        spec->ratio = anchor->ratio;
         return;
     }
-    // Anchored to the parent
-    if (!anchor->reference) return;
-
     // Anchored to a sibling
     if (anchor->edge == 0){
         switch (edge){
@@ -157,39 +106,88 @@ void win32_edge_list_prepend_referred_edges(Win32EdgeList *list, Win32Window *it
                 break;
         }
     }
-    // Check if the anchored window's edge is already in the list
-    if ( win32_edge_list_includes(list, anchor->reference, anchor->edge) ) return;
-
-    win32_edge_list_prepend_referred_edges(list, anchor->reference, anchor->edge);
-    win32_edge_list_append(list, anchor->reference, anchor->edge);
+    // The sibling must be a child of the same container
+    size_t reference = anchor->reference->positioning->_index;
+    if ( reference >= container->childWindows.length ||
+         container->childWindows.items[reference] != anchor->reference ) return;
+
+    spec->kind    = LAYOUT_ANCHOR_SIBLING;
+    spec->sibling = reference;
+    spec->edge    = anchor->edge;
 }
 
 
-/* INTERNAL LAYOUT UTILITY
+/* INTERNAL LAYOUT SETUP
 ------------------------------------------- */
-void win32_edge_list_append(Win32EdgeList *list, Win32Window *item, int edge)
+// Describes the anchors of the children to the solver, which builds the
+// calculation order of the edges
+void win32_relative_layout_configure(Win32Container* container)
 {
-    // insert the item into the first available spot
-    size_t length = list->length;
-    for ( int i=0; i<length; i++ ){
-        if ( list->items[i].window == NULL ){
-            list->items[i].window = item;
-            list->items[i].edge = edge;
-            break;
+    Win32RelativeLayout *layout = (Win32RelativeLayout*) container->layout;
+
+    Win32Window ** children = container->childWindows.items;
+    size_t numChildren      = container->childWindows.length;
+
+    Win32LayoutItem *items = win32_layout_solver_set_size (&layout->solver, numChildren);
+
+    for (size_t i=0; i<numChildren; i++) children[i]->positioning->_index = i;
+
+    for (size_t i=0; i<numChildren; i++)
+    {
+        for (int n=0; n<4; n++){
+            Win32Anchor *anchor = win32_layout_data_get_anchor (children[i]->positioning, 1 << n);
+            win32_relative_layout_describe_anchor (container, anchor, 1 << n, &items[i].anchors[n]);
+            if ( anchor ) anchor->retargeted = FALSE;
         }
+        children[i]->positioning->_reanchored = FALSE;
+        items[i].dirty = EDGE_ALL;
     }
+    win32_layout_solver_plan (&layout->solver);
+    layout->layout.stale = FALSE;
 }
 
 
-/* INTERNAL LAYOUT UTILITY
+/* INTERNAL LAYOUT CLEANUP
 ------------------------------------------- */
-BOOL win32_edge_list_includes(Win32EdgeList *list, Win32Window *item, int edge)
+void win32_relative_layout_finalize(Win32Layout* instance)
 {
-    size_t length = list->length;
-    for ( int i=0; i<length; i++ ){
-        if ( list->items[i].window == item && list->items[i].edge == edge ) return TRUE;
-    }
-    return FALSE;
+    Win32RelativeLayout *layout = (Win32RelativeLayout*) instance;
+
+    win32_layout_solver_clear (&layout->solver);
+}
+
+
+/* INTERNAL LAYOUT SINK
+------------------------------------------- */
+// Applies the rectangles calculated by the solver to the children of a container
+typedef struct _Win32ContainerSink {
+    Win32LayoutSink sink;
+    Win32Container *container;
+} Win32ContainerSink;
+
+static void win32_container_sink_begin (Win32LayoutSink *sink, size_t numItems)
+{
+    Win32ContainerSink *self = (Win32ContainerSink*) sink;
+    win32_layout_begin_commit (self->container->layout, numItems);
+}
+
+static void win32_container_sink_place (Win32LayoutSink *sink, size_t index, int left, int top, int width, int height)
+{
+    Win32ContainerSink *self = (Win32ContainerSink*) sink;
+    RECT bounds = { left, top, left + width, top + height };
+
+    win32_layout_commit_window (self->container->layout, self->container->childWindows.items[index], &bounds);
+}
+
+static void win32_container_sink_end (Win32LayoutSink *sink)
+{
+    Win32ContainerSink *self = (Win32ContainerSink*) sink;
+    Win32Window *window = (Win32Window*) self->container;
+    win32_layout_end_commit (self->container->layout);
+
+    // Lazily realized children may have moved into view, or far out of it
+    if ( self->container->realization != CONTAINER_REALIZE_EAGER && window->hwnd != NULL )
+        WIN32_WINDOW_GET_CLASS (window)->realize (window);
 }
 
 
@@ -200,141 +198,171 @@ void win32_relative_layout_recalculate(Win32Container* container)
     Win32RelativeLayout *layout = (Win32RelativeLayout*) container->layout;
     Win32Window * window = (Win32Window*) container;
 
-    double scale = (double) layout->scale;
-    UINT halfSpacing_L = layout->vSpacing / 2 + (layout->vSpacing % 2);
-    UINT halfSpacing_R = layout->vSpacing / 2;
-    UINT halfSpacing_T = layout->hSpacing / 2 + (layout->hSpacing % 2);
-    UINT halfSpacing_B = layout->hSpacing / 2;
+    Win32Window ** children = container->childWindows.items;
+    size_t numChildren      = container->childWindows.length;
+    Win32Window *child;
+    Win32Anchor *anchor;
+
+    // Children were added, or their anchors replaced or re-targeted, since the plan was built
+    for (size_t i=0; i<numChildren && !layout->layout.stale; i++){
+        if ( children[i]->positioning->_reanchored ) layout->layout.stale = TRUE;
+        for (int n=0; n<4; n++){
+            anchor = win32_layout_data_get_anchor (children[i]->positioning, 1 << n);
+            if ( anchor && anchor->retargeted ) layout->layout.stale = TRUE;
+        }
+    }
+    if ( layout->layout.stale ) win32_relative_layout_configure (container);
+    Win32LayoutItem *items  = layout->solver.items;
+
+    // Hand the sizes and the dirty flags of the children over to the solver, the
+    // children without a window are planned with their preferred size, if any
+    for (size_t i=0; i<numChildren; i++)
+    {
+        child = children[i];
+        items[i].width  = (child->hwnd != NULL || child->pref_width == 0)  ? child->width  : child->pref_width;
+        items[i].height = (child->hwnd != NULL || child->pref_height == 0) ? child->height : child->pref_height;
+        items[i].dirty |= children[i]->positioning->dirty;
+        children[i]->positioning->dirty = 0;
+
+        for (int n=0; n<4; n++){
+            anchor = win32_layout_data_get_anchor (children[i]->positioning, 1 << n);
+            if ( anchor && anchor->dirty ) items[i].anchors[n].dirty = TRUE;
+        }
+    }
+    // An anchor may be shared by several children, so it is cleared afterwards
+    for (size_t i=0; i<numChildren; i++){
+        for (int n=0; n<4; n++){
+            anchor = win32_layout_data_get_anchor (children[i]->positioning, 1 << n);
+            if ( anchor ) anchor->dirty = FALSE;
+        }
+    }
+
+    Win32LayoutMetrics metrics = { layout->vPadding, layout->hPadding, layout->hSpacing, layout->vSpacing, layout->scale };
+    Win32ContainerSink sink = {
+        { win32_container_sink_begin, win32_container_sink_place, win32_container_sink_end },
+        container
+    };
 
     RECT rect;
+    WIN32_COUNT_CALL (WIN32_CALL_GET_CLIENT_RECT);
     GetClientRect( window->hwnd, &rect);
-    int containerWidth  = rect.right - rect.left - 2 * layout->vPadding + layout->vSpacing;
-    int containerHeight = rect.bottom - rect.top - 2 * layout->hPadding + layout->hSpacing;
+    win32_layout_solver_solve (&layout->solver, &metrics, rect.right - rect.left, rect.bottom - rect.top,
+                               (Win32LayoutSink*) &sink);
+}
 
-    Win32EdgeList *edgeList = &layout->edgeList;
 
-    Win32Window *child;
-    Win32Window *reference;
-    int *left, *top, *bottom, *right, withPadding;
-    for (int i=0; i< edgeList->length; i++)
-    {
-        child = edgeList->items[i].window;
-
-        switch ( edgeList->items[i].edge )
-        {
-        case EDGE_LEFT:
-            left = &child->positioning->_left;
-
-            if ( child->positioning->left ){
-                // Positioning relative to a sibling
-                // [!] Assignment is intentional
-                if ( reference = child->positioning->left->reference ){
-                    if ( child->positioning->left->edge == EDGE_RIGHT ){
-                        *left = reference->positioning->_right + layout->vSpacing;;
-                    } else if ( child->positioning->left->edge == EDGE_LEFT ){
-                        *left = reference->positioning->_left;
-                    }
-                // Positioning relative to the parent
-                } else {
-                    *left = child->positioning->left->ratio / scale * containerWidth;
-                    // Add spacing
-                    *left += halfSpacing_R;
-                }
-            // No anchor is provided
-            } else if (child->positioning->right){
-                *left = child->positioning->_right - child->width;
-            } else {
-                *left = halfSpacing_R; // 0
-            }
-            break;
-
-        case EDGE_TOP:
-            top = &child->positioning->_top;
-
-            if ( child->positioning->top ){
-                // Positioning relative to a sibling
-                // [!] Assignment is intentional
-                if ( reference = child->positioning->top->reference ){
-                    if ( child->positioning->top->edge == EDGE_BOTTOM ){
-                        *top = reference->positioning->_bottom + layout->hSpacing;
-                    } else if ( child->positioning->top->edge == EDGE_TOP ){
-                        *top = reference->positioning->_top;
-                    }
-                // Positioning relative to the parent
-                } else {
-                    *top = child->positioning->top->ratio / scale * containerHeight;
-                    // Add spacing
-                    *top += halfSpacing_B;
-                }
-            // No anchor is provided
-            } else if (child->positioning->bottom){
-                *top = child->positioning->_bottom - child->height;
-            } else {
-                *top = halfSpacing_B; // 0
-            }
-            break;
-
-        case EDGE_RIGHT:
-            right = &child->positioning->_right;
-
-            if ( child->positioning->right ){
-                // Positioning relative to a sibling
-                // [!] Assignment is intentional
-                if ( reference = child->positioning->right->reference ){
-                    if ( child->positioning->right->edge == EDGE_RIGHT ){
-                        *right = reference->positioning->_right;
-                    } else if ( child->positioning->right->edge == EDGE_LEFT ){
-                        *right = reference->positioning->_left - layout->vSpacing;
-                    }
-                // Positioning relative to the parent
-                } else {
-                    *right = child->positioning->right->ratio / scale * containerWidth;
-                    // Add spacing
-                    *right -= halfSpacing_L;
-                }
-            // No anchor is provided
-            } else *right = child->positioning->_left + child->width;
-
-            break;
-
-        case EDGE_BOTTOM:
-            bottom = &child->positioning->_bottom;
-
-            if ( child->positioning->bottom ){
-                // Positioning relative to a sibling
-                // [!] Assignment is intentional
-                if ( reference = child->positioning->bottom->reference ){
-                    if ( child->positioning->bottom->edge == EDGE_BOTTOM ){
-                        *bottom = reference->positioning->_bottom;
-                    } else if ( child->positioning->bottom->edge == EDGE_TOP ){
-                        *bottom = reference->positioning->_top - layout->hSpacing;
-                    }
-                // Positioning relative to the parent
-                } else {
-                    *bottom = child->positioning->bottom->ratio / scale * containerHeight;
-                    // Add spacing
-                    *bottom -= halfSpacing_T;
-                }
-            // No anchor is provided
-            } else *bottom = child->positioning->_top + child->height;
-
-            break;
+/* INTERNAL GEOMETRY COMMIT
+------------------------------------------- */
+// Layouts apply the calculated rectangles in a single deferred window positioning
+// transaction so the children are moved and repainted at once.
+void win32_layout_begin_commit (Win32Layout *self, int numWindows)
+{
+    // The transaction is started by the first window that actually moves
+    self->deferredPositions = NULL;
+    self->numDeferred = numWindows;
+    self->deferredLength = 0;
+}
+
+
+/* INTERNAL GEOMETRY COMMIT
+------------------------------------------- */
+// The rectangle is only recorded once the window has really been moved, so a
+// window whose move failed is positioned again by the next commit.
+static void win32_layout_record_window (Win32Window *window, BOOL placed)
+{
+    Win32LayoutData *positioning = window->positioning;
+
+    positioning->_bounds.left   = window->left;
+    positioning->_bounds.top    = window->top;
+    positioning->_bounds.right  = window->left + window->width;
+    positioning->_bounds.bottom = window->top + window->height;
+    positioning->_placed = placed;
+}
+
+static void win32_layout_move_window (Win32Window *window)
+{
+    BOOL placed;
+
+    WIN32_COUNT_CALL (WIN32_CALL_SET_WINDOW_POS);
+    placed = SetWindowPos (window->hwnd, NULL, window->left, window->top, window->width, window->height,
+                           SWP_NOZORDER | SWP_NOACTIVATE);
+    win32_layout_record_window (window, placed);
+}
+
+// A failed transaction moves none of its windows, they are moved one by one instead
+static void win32_layout_move_deferred (Win32Layout *self)
+{
+    for (int i=0; i<self->deferredLength; i++) win32_layout_move_window (self->deferredWindows[i]);
+    self->deferredLength = 0;
+}
+
+
+/* INTERNAL GEOMETRY COMMIT
+------------------------------------------- */
+void win32_layout_commit_window (Win32Layout *self, Win32Window *window, const RECT *bounds)
+{
+    Win32LayoutData *positioning = window->positioning;
+
+    // Windows whose rectangle did not change are left alone
+    if ( positioning->_placed && window->hwnd != NULL &&
+         bounds->left  == positioning->_bounds.left  && bounds->top    == positioning->_bounds.top &&
+         bounds->right == positioning->_bounds.right && bounds->bottom == positioning->_bounds.bottom ) return;
+
+    window->left   = bounds->left;
+    window->top    = bounds->top;
+    window->width  = bounds->right - bounds->left;
+    window->height = bounds->bottom - bounds->top;
+
+    // The rectangle of a window yet to be created is applied on creation
+    if ( window->hwnd == NULL ){
+        positioning->_placed = FALSE;
+        return;
+    }
+
+    if ( self->deferredPositions == NULL && self->numDeferred > 0 ){
+        self->deferredPositions = BeginDeferWindowPos (self->numDeferred);
+        // Fall back to moving the windows one by one
+        if ( self->deferredPositions == NULL ) self->numDeferred = 0;
+    }
+
+    if ( self->deferredPositions != NULL ){
+        if ( self->deferredLength == self->deferredCapacity ){
+            self->deferredCapacity = self->deferredCapacity ? self->deferredCapacity * 2 : self->numDeferred;
+            self->deferredWindows  = realloc( self->deferredWindows, sizeof(Win32Window*) * self->deferredCapacity );
         }
-    }// END LOOP
 
-    int width, height;
-    size_t numChildren = container->childWindows.length;
-    for (int i=0; i<numChildren; i++ )
-    {
-        child = container->childWindows.items[i];
+        WIN32_COUNT_CALL (WIN32_CALL_DEFER_WINDOW_POS);
+        self->deferredPositions = DeferWindowPos (self->deferredPositions, window->hwnd, NULL,
+                                                  window->left, window->top, window->width, window->height,
+                                                  SWP_NOZORDER | SWP_NOACTIVATE);
+        if ( self->deferredPositions != NULL ){
+            self->deferredWindows[self->deferredLength++] = window;
+            return;
+        }
+        // A failed DeferWindowPos call discards the whole transaction
+        self->numDeferred = 0;
+        win32_layout_move_deferred (self);
+    }
 
-        width = child->positioning->_right - child->positioning->_left;
-        height = child->positioning->_bottom - child->positioning->_top;
+    win32_layout_move_window (window);
+}
 
-        win32_window_move_and_resize  ( (Win32Window*) child, child->positioning->_left + layout->vPadding - halfSpacing_R,
-                                  child->positioning->_top + layout->hPadding - halfSpacing_B, width, height);
 
+/* INTERNAL GEOMETRY COMMIT
+------------------------------------------- */
+void win32_layout_end_commit (Win32Layout *self)
+{
+    if ( self->deferredPositions != NULL ){
+        if ( EndDeferWindowPos (self->deferredPositions) ){
+            for (int i=0; i<self->deferredLength; i++) win32_layout_record_window (self->deferredWindows[i], TRUE);
+        } else {
+            win32_layout_move_deferred (self);
+        }
     }
+
+    self->deferredPositions = NULL;
+    self->numDeferred = 0;
+    self->deferredLength = 0;
 }
 
 
@@ -343,7 +371,7 @@ void win32_relative_layout_recalculate(Win32Container* container)
 void* win32_layout_ref (void* instance)
 {
     Win32Layout * self = instance;
-    g_atomic_int_inc (&self->ref_count);
+    WIN32_REF_INC (self->ref_count);
     return self;
 }
 
@@ -353,7 +381,9 @@ void* win32_layout_ref (void* instance)
 void win32_layout_unref (void* instance)
 {
     Win32Layout * self = instance;
-    if (g_atomic_int_dec_and_test (&self->ref_count)) {
+    if (WIN32_REF_DEC_AND_TEST (self->ref_count)) {
+        if (self->finalize) self->finalize (self);
+        free (self->deferredWindows);
         free (self);
     }
 }
@@ -366,14 +396,14 @@ void win32_layout_unref (void* instance)
 ------------------------------------------- */
 Win32Anchor *win32_anchor_to_parent( UINT ratio, int offset )
 {
-    Win32Anchor* anchor = malloc( sizeof(Win32Anchor) );
-    memset( anchor, 0, sizeof(Win32Anchor) );
+    Win32Anchor* anchor = win32_pool_alloc( WIN32_POOL_ANCHOR );
 
     // increase reference count
     win32_anchor_ref( anchor );
 
     anchor->ratio = ratio;
     anchor->offset = offset;
+    anchor->dirty = TRUE;
 
     return anchor;
 }
@@ -383,14 +413,14 @@ Win32Anchor *win32_anchor_to_parent( UINT ratio, int offset )
 ------------------------------------------- */
 Win32Anchor *win32_anchor_to_sibling( Win32Window *sibling, int offset )
 {
-    Win32Anchor* anchor = malloc( sizeof(Win32Anchor) );
-    memset( anchor, 0, sizeof(Win32Anchor) );
+    Win32Anchor* anchor = win32_pool_alloc( WIN32_POOL_ANCHOR );
 
     // increase reference count
     win32_anchor_ref( anchor );
 
     anchor->reference = sibling;
     anchor->offset = offset;
+    anchor->dirty = TRUE;
 
     return anchor;
 }
@@ -400,7 +430,9 @@ Win32Anchor *win32_anchor_to_sibling( Win32Window *sibling, int offset )
 ------------------------------------------- */
 Win32Anchor *win32_anchor_to_edge(Win32Anchor *self, int edge)
 {
+    if ( self->edge != edge ) self->retargeted = TRUE;
     self->edge = edge;
+    self->dirty = TRUE;
     return self;
 }
 
@@ -410,6 +442,7 @@ Win32Anchor *win32_anchor_to_edge(Win32Anchor *self, int edge)
 Win32Anchor *win32_anchor_with_offset(Win32Anchor *self, int offset)
 {
     self->offset = offset;
+    self->dirty = TRUE;
     return self;
 }
 
@@ -419,7 +452,7 @@ Win32Anchor *win32_anchor_with_offset(Win32Anchor *self, int offset)
 void* win32_anchor_ref (void* instance)
 {
     Win32Anchor * self = (Win32Anchor *) instance;
-    g_atomic_int_inc (&self->ref_count);
+    WIN32_REF_INC (self->ref_count);
     return self;
 }
 
@@ -429,8 +462,8 @@ void* win32_anchor_ref (void* instance)
 void win32_anchor_unref (void* instance)
 {
     Win32Anchor * self = instance;
-    if (g_atomic_int_dec_and_test (&self->ref_count)) {
-        free (self);
+    if (WIN32_REF_DEC_AND_TEST (self->ref_count)) {
+        win32_pool_free (WIN32_POOL_ANCHOR, self);
     }
 }
 
@@ -442,8 +475,7 @@ Win32LayoutData *win32_layout_data_new (void)
 {
     Win32LayoutData *instance;
 
-    instance = malloc( sizeof(Win32LayoutData) );
-    memset( instance, 0, sizeof(Win32LayoutData) );
+    instance = win32_pool_alloc( WIN32_POOL_LAYOUT_DATA );
     win32_layout_data_ref (instance);
 
     return instance;
@@ -463,6 +495,8 @@ void  win32_layout_data_set_left (Win32LayoutData *instance, Win32Anchor* anchor
     win32_anchor_ref( anchor );
 
     instance->left = anchor;
+    // the anchor may refer to another sibling, the plan has to be rebuilt
+    instance->_reanchored = TRUE;
 }
 
 
@@ -488,6 +522,8 @@ void  win32_layout_data_set_top (Win32LayoutData *instance, Win32Anchor* anchor)
     win32_anchor_ref( anchor );
 
     instance->top = anchor;
+    // the anchor may refer to another sibling, the plan has to be rebuilt
+    instance->_reanchored = TRUE;
 }
 
 
@@ -513,6 +549,8 @@ void  win32_layout_data_set_right (Win32LayoutData *instance, Win32Anchor* ancho
     win32_anchor_ref( anchor );
 
     instance->right = anchor;
+    // the anchor may refer to another sibling, the plan has to be rebuilt
+    instance->_reanchored = TRUE;
 }
 
 
@@ -538,6 +576,8 @@ void  win32_layout_data_set_bottom (Win32LayoutData *instance, Win32Anchor* anch
     win32_anchor_ref( anchor );
 
     instance->bottom = anchor;
+    // the anchor may refer to another sibling, the plan has to be rebuilt
+    instance->_reanchored = TRUE;
 }
 
 
@@ -549,12 +589,22 @@ Win32Anchor* win32_layout_data_get_bottom (Win32LayoutData *instance)
 }
 
 
+/* INTERNAL INVALIDATE
+------------------------------------------- */
+// Marks the edges of the window for recalculation and its rectangle to be applied again
+void win32_layout_data_invalidate (Win32LayoutData *instance, int edges)
+{
+    instance->dirty |= edges;
+    instance->_placed = FALSE;
+}
+
+
 /* INTERNAL REF LAYOUT DATA
 ------------------------------------------- */
 void* win32_layout_data_ref (void* instance)
 {
     Win32LayoutData * self = instance;
-    g_atomic_int_inc (&self->ref_count);
+    WIN32_REF_INC (self->ref_count);
     return self;
 }
 
@@ -564,7 +614,12 @@ void* win32_layout_data_ref (void* instance)
 void win32_layout_data_unref (void* instance)
 {
     Win32LayoutData * self = instance;
-    if (g_atomic_int_dec_and_test (&self->ref_count)) {
-        free (self);
+    if (WIN32_REF_DEC_AND_TEST (self->ref_count)) {
+        // the anchors go back to their pool with the data that holds them
+        _win32_anchor_unref0 (self->left);
+        _win32_anchor_unref0 (self->top);
+        _win32_anchor_unref0 (self->right);
+        _win32_anchor_unref0 (self->bottom);
+        win32_pool_free (WIN32_POOL_LAYOUT_DATA, self);
     }
 }
@@ -8,11 +8,7 @@
 
 #include <windows.h>
 #include <glib-object.h>
-
-#define EDGE_LEFT     1
-#define EDGE_TOP      2
-#define EDGE_RIGHT    4
-#define EDGE_BOTTOM   8
+#include "layout-solver.h"
 
 #define _win32_anchor_unref0(var)   ((var == NULL) ? NULL : (var = (win32_anchor_unref (var), NULL)))
 #define _win32_layout_unref0(var) ((var == NULL) ? NULL : (var = (win32_layout_unref (var), NULL)))
@@ -25,6 +21,8 @@ typedef struct _Win32Anchor {
     UINT ratio;
     int offset;
     int edge;
+    BOOL dirty;  // the anchored edge needs to be recalculated
+    BOOL retargeted;  // points at another edge, the plan has to be rebuilt
 } Win32Anchor;
 
 Win32Anchor *win32_anchor_to_parent( UINT ratio, int offset );
@@ -45,12 +43,11 @@ typedef struct _Win32LayoutData {
     Win32Anchor *top;
     Win32Anchor *right;
     Win32Anchor *bottom;
-    int _left;
-    int _top;
-    int _right;
-    int _bottom;
-    int _width;
-    int _height;
+    size_t _index;  // position of the window in its container, assigned by the layout
+    int dirty;      // edges to be recalculated, see EDGE_* flags
+    RECT _bounds;   // the last rectangle applied to the window
+    BOOL _placed;
+    BOOL _reanchored;  // an anchor was replaced, the plan has to be rebuilt
 } Win32LayoutData;
 
 Win32LayoutData* win32_layout_data_new (void);
@@ -70,31 +67,37 @@ Win32Anchor* win32_layout_data_get_bottom (Win32LayoutData *instance);
 /* INTERNAL */
 void* win32_layout_data_ref   (void*);
 void  win32_layout_data_unref (void*);
+void  win32_layout_data_invalidate (Win32LayoutData *instance, int edges);
+
 
+typedef struct _Win32Layout Win32Layout;
 
-typedef struct _Win32Layout {
+struct _Win32Layout {
     volatile int ref_count;
     void (*recalculate)(Win32Container *container);
     void (*configure)  (Win32Container *container);
-} Win32Layout;
+    void (*finalize)   (Win32Layout *layout);
+    BOOL stale;              // children or their anchors changed, the plan has to be rebuilt
+    HDWP deferredPositions;  // geometry commit in progress
+    int  numDeferred;        // number of windows the commit is expected to move
+    Win32Window **deferredWindows;  // windows added to the transaction, recorded once it ends
+    int  deferredLength;
+    int  deferredCapacity;
+};
 
 /* INTERNAL */
 void* win32_layout_ref   (void*);
 void  win32_layout_unref (void*);
 
+void win32_layout_begin_commit  (Win32Layout *layout, int numWindows);
+void win32_layout_commit_window (Win32Layout *layout, Win32Window *window, const RECT *bounds);
+void win32_layout_end_commit    (Win32Layout *layout);
+
 
 /* CLASS RelativeLayout
 ------------------------------------------- */
-typedef struct _Win32EdgeListItem {
-    Win32Window * window;
-    int edge;
-} Win32EdgeListItem;
-
-typedef struct _Win32EdgeList {
-    Win32EdgeListItem * items;
-    size_t length;
-} Win32EdgeList;
-
+// The children are described to a headless solver (see layout-solver.h) which
+// calculates the rectangles, the layout only applies them to the windows.
 typedef struct _Win32RelativeLayout {
     Win32Layout layout;
     UINT vPadding;
@@ -102,7 +105,7 @@ typedef struct _Win32RelativeLayout {
     UINT hSpacing;
     UINT vSpacing;
     UINT scale;
-    Win32EdgeList edgeList;
+    Win32LayoutSolver solver;
 } Win32RelativeLayout;
 
 Win32RelativeLayout* win32_relative_layout_new (UINT padding, UINT spacing);
@@ -111,6 +114,7 @@ Win32RelativeLayout* win32_relative_layout_with_spacing(Win32RelativeLayout* sel
 Win32RelativeLayout* win32_relative_layout_with_padding(Win32RelativeLayout* self, UINT vPadding, UINT hPadding);
 void win32_relative_layout_recalculate(Win32Container* container);
 void win32_relative_layout_configure(Win32Container* container);
+void win32_relative_layout_finalize(Win32Layout* layout);
 
 
 #endif
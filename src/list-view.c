@@ -0,0 +1,335 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+static const wchar_t *szClassName = L"Win32ListView";
+static WNDPROC g_baseProc = NULL;  // procedure of the system class, see the superclass
+static gpointer win32_list_view_parent_class = NULL;
+
+static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+static GType win32_list_view_get_type_once (void);
+static void win32_list_view_finalize (Win32Window * obj);
+
+HWND win32_list_view_create (Win32Window *self, Win32Window *parent);
+
+/* CONSTRUCTOR
+------------------------------------------- */
+Win32ListView* win32_list_view_construct (GType object_type, Win32Window* parent)
+{
+    Win32ListView* self = NULL;
+    self = (Win32ListView*) win32_control_construct (object_type, parent, win32_list_view_create, NULL);
+    return self;
+}
+
+Win32ListView* win32_list_view_new (Win32Window* parent)
+{
+    return win32_list_view_construct (WIN32_TYPE_LIST_VIEW, parent);
+}
+
+
+/* INTERNAL INSERT COLUMN
+------------------------------------------- */
+static void win32_list_view_insert_column (Win32ListView *self, int index)
+{
+    Win32Window *window = (Win32Window*) self;
+    Win32WideString title;
+    win32_wide_string_init( &title, self->columns[index].title );
+
+    LVCOLUMN column;
+    memset( &column, 0, sizeof(LVCOLUMN) );
+    column.mask     = LVCF_TEXT | LVCF_WIDTH | LVCF_SUBITEM;
+    column.pszText  = (wchar_t*) title.str;
+    column.cx       = self->columns[index].width;
+    column.iSubItem = index;
+    SendMessage( window->hwnd, LVM_INSERTCOLUMN, index, (LPARAM) &column );
+
+    win32_wide_string_release( &title );
+}
+
+
+/* INTERNAL CREATE
+------------------------------------------- */
+HWND win32_list_view_create (Win32Window *self, Win32Window *parent)
+{
+    HWND hwnd;
+    Win32Window   *window   = (Win32Window*) self;
+    Win32Control  *control  = (Win32Control*) self;
+    Win32ListView *listView = (Win32ListView*) self;
+
+    // default size
+    window->width  = (window->pref_width > 0) ? window->pref_width : 200;
+    window->height = (window->pref_height > 0) ? window->pref_height : 150;
+
+    control->id = win32_control_generate_ID ();
+
+    // Creating the Window
+    hwnd = CreateWindowEx(
+        WS_EX_CLIENTEDGE,
+        szClassName,
+        L"",
+        // Control Styles:
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | LVS_REPORT | LVS_OWNERDATA | LVS_SHOWSELALWAYS,
+        window->left,   // x position
+        window->top,    // y position
+        window->width,  // width
+        window->height, // height
+        parent->hwnd,   // Parent window
+        (HANDLE) control->id, // Control ID
+        window->hInstance,
+        window );
+
+    // window->hwnd is assigned on WM_NCCREATE
+    if ( hwnd == NULL ) return NULL;
+
+    SendMessage( hwnd, LVM_SETEXTENDEDLISTVIEWSTYLE, 0, LVS_EX_FULLROWSELECT | LVS_EX_DOUBLEBUFFER );
+    for (int i=0; i<listView->numColumns; i++) win32_list_view_insert_column (listView, i);
+    SendMessage( hwnd, LVM_SETITEMCOUNT, listView->rowCount, LVSICF_NOINVALIDATEALL );
+
+    return hwnd;
+}
+
+
+/* METHOD ADD COLUMN
+------------------------------------------- */
+void win32_list_view_add_column (Win32ListView *instance, const char *title, int width)
+{
+    if ( instance->numColumns == instance->capacity ){
+        int capacity = ( instance->capacity > 0 ) ? instance->capacity * 2 : 4;
+        Win32ListColumn *columns = realloc( instance->columns, capacity * sizeof(Win32ListColumn) );
+        if ( columns == NULL ) return;
+        instance->columns  = columns;
+        instance->capacity = capacity;
+    }
+
+    Win32ListColumn *column = &instance->columns[instance->numColumns];
+    column->title = _strdup( ( title != NULL ) ? title : "" );
+    column->width = width;
+    instance->numColumns += 1;
+
+    if ( ((Win32Window*) instance)->hwnd != NULL ) win32_list_view_insert_column (instance, instance->numColumns - 1);
+}
+
+
+/* PROPERTY SET ROW COUNT
+------------------------------------------- */
+// Only the visible rows are repainted, the scroll position is kept
+void win32_list_view_set_row_count (Win32ListView *instance, int count)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( count < 0 ) count = 0;
+    instance->rowCount = count;
+
+    if ( window->hwnd != NULL ){
+        SendMessage( window->hwnd, LVM_SETITEMCOUNT, count, LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL );
+    }
+}
+
+
+/* PROPERTY GET ROW COUNT
+------------------------------------------- */
+int win32_list_view_get_row_count (Win32ListView *instance)
+{
+    return instance->rowCount;
+}
+
+
+/* METHOD SET DATA PROVIDER
+------------------------------------------- */
+void win32_list_view_set_data_provider (Win32ListView *instance,
+                                        Win32ListDataProvider provider,
+                                        void *boundData,
+                                        Win32ReleaseFunction releaseData)
+{
+    if ( instance->releaseProviderData != NULL ) instance->releaseProviderData (instance->providerData);
+
+    instance->provider = provider;
+    instance->providerData = boundData;
+    instance->releaseProviderData = releaseData;
+
+    win32_list_view_redraw_rows (instance, 0, instance->rowCount - 1);
+}
+
+
+/* METHOD SET CACHE HINT
+------------------------------------------- */
+// The hint is called before the control asks for a range of rows, so that
+// the provider can fetch them at once
+void win32_list_view_set_cache_hint (Win32ListView *instance,
+                                     Win32ListCacheHint hint,
+                                     void *boundData,
+                                     Win32ReleaseFunction releaseData)
+{
+    if ( instance->releaseCacheHintData != NULL ) instance->releaseCacheHintData (instance->cacheHintData);
+
+    instance->cacheHint = hint;
+    instance->cacheHintData = boundData;
+    instance->releaseCacheHintData = releaseData;
+}
+
+
+/* METHOD REDRAW ROWS
+------------------------------------------- */
+// Asks the provider again for the rows in the range that are visible
+void win32_list_view_redraw_rows (Win32ListView *instance, int first, int last)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL || last < first ) return;
+
+    SendMessage( window->hwnd, LVM_REDRAWITEMS, first, last );
+}
+
+
+/* INTERNAL CELL TEXT
+------------------------------------------- */
+// The control accepts a pointer to the text instead of a copy in its buffer,
+// the same buffer serves every cell
+static void win32_list_view_get_cell_text (Win32ListView *self, LVITEM *item)
+{
+    char *text = self->provider (item->iItem, item->iSubItem, self->providerData);
+    size_t length = ( text != NULL ) ? strlen (text) : 0;
+
+    if ( UTF16_MAX_LENGTH(length) + 1 > self->cellCapacity ){
+        size_t capacity = UTF16_MAX_LENGTH(length) + 1;
+        if ( capacity < 64 ) capacity = 64;
+        wchar_t *buffer = realloc( self->cellText, capacity * sizeof(wchar_t) );
+        if ( buffer == NULL ){
+            g_free (text);
+            return;
+        }
+        self->cellText = buffer;
+        self->cellCapacity = capacity;
+    }
+
+    self->cellText[ win32_utf8_to_utf16 (text, length, (uint16_t*) self->cellText) ] = 0;
+    item->pszText = self->cellText;
+
+    g_free (text);
+}
+
+
+/* INTERNAL NOTIFICATIONS
+------------------------------------------- */
+// Notifications are forwarded by the parent window as FM_NOTIFY
+static LRESULT win32_list_view_notify (Win32ListView *self, NMHDR *header)
+{
+    switch (header->code){
+        case LVN_GETDISPINFO: {
+            LVITEM *item = &((NMLVDISPINFO*) header)->item;
+            if ( (item->mask & LVIF_TEXT) && self->provider != NULL ) win32_list_view_get_cell_text (self, item);
+            return 0; }
+
+        case LVN_ODCACHEHINT: {
+            NMLVCACHEHINT *hint = (NMLVCACHEHINT*) header;
+            if ( self->cacheHint != NULL ) self->cacheHint (hint->iFrom, hint->iTo, self->cacheHintData);
+            return 0; }
+
+        case LVN_ODFINDITEM:
+            // Typing to select isn't supported, there's no text to search in
+            return -1;
+    }
+    return 0;
+}
+
+
+/* INTERNAL WINDOW PROCEDURE
+------------------------------------------- */
+// the Window Procedure
+LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    WIN32_PROFILE_BEGIN (start);
+    LRESULT result;
+    result = win32_window_default_procedure(hwnd, msg, wParam, lParam);
+    if ( result == STOP_PROPAGATION ) return WIN32_PROFILE_MESSAGE (msg, start, 0);
+
+    if ( msg == FM_NOTIFY ){
+        Win32ListView *self = (Win32ListView*) GetWindowLongPtr( hwnd, GWLP_USERDATA );
+        return WIN32_PROFILE_MESSAGE (msg, start, ( self != NULL ) ? win32_list_view_notify (self, (NMHDR*) lParam) : 0);
+    }
+
+    return WIN32_PROFILE_MESSAGE (msg, start, CallWindowProc( g_baseProc, hwnd, msg, wParam, lParam));
+}
+
+
+/* INTERNAL GTYPE
+------------------------------------------- */
+static void win32_list_view_class_init (Win32ListViewClass * klass, gpointer klass_data)
+{
+    win32_list_view_parent_class = g_type_class_peek_parent (klass);
+    ((Win32WindowClass *) klass)->finalize = win32_list_view_finalize;
+
+    // The system class is registered by the common controls library
+    INITCOMMONCONTROLSEX controls = { sizeof(INITCOMMONCONTROLSEX), ICC_LISTVIEW_CLASSES };
+    InitCommonControlsEx (&controls);
+
+    // Register the superclass once, every list view shares it
+    g_baseProc = win32_control_register_superclass( WC_LISTVIEW, szClassName, WndProc );
+    if ( g_baseProc == NULL ){
+        MessageBox(NULL, L"Window Registration Failed!", L"Error!", MB_ICONEXCLAMATION | MB_OK);
+        exit (1); // exit
+    }
+}
+
+static void win32_list_view_instance_init (Win32ListView * self, gpointer klass)
+{
+}
+
+/* INTERNAL CLEANUP
+------------------------------------------- */
+static void win32_list_view_finalize (Win32Window * obj)
+{
+    Win32ListView * self;
+    self = G_TYPE_CHECK_INSTANCE_CAST (obj, WIN32_TYPE_LIST_VIEW, Win32ListView);
+
+    // The control may still notify while it is destroyed, there's nothing to provide by then
+    if ( self->releaseProviderData != NULL ) self->releaseProviderData (self->providerData);
+    if ( self->releaseCacheHintData != NULL ) self->releaseCacheHintData (self->cacheHintData);
+    self->provider  = NULL;
+    self->cacheHint = NULL;
+
+    for (int i=0; i<self->numColumns; i++) free (self->columns[i].title);
+    free (self->columns);
+    self->columns = NULL;
+    self->numColumns = 0;
+
+    free (self->cellText);
+    self->cellText = NULL;
+    self->cellCapacity = 0;
+
+    WIN32_WINDOW_CLASS (win32_list_view_parent_class)->finalize (obj);
+}
+
+
+/* INTERNAL GTYPE REGISTRATION
+------------------------------------------- */
+static GType win32_list_view_get_type_once (void)
+{
+    static const GTypeInfo g_define_type_info = {
+        sizeof (Win32ListViewClass),
+        (GBaseInitFunc) NULL,
+        (GBaseFinalizeFunc) NULL,
+        (GClassInitFunc) win32_list_view_class_init,
+        (GClassFinalizeFunc) NULL,
+        NULL,
+        sizeof (Win32ListView),
+        0,
+        (GInstanceInitFunc) win32_list_view_instance_init,
+        NULL
+    };
+    GType win32_list_view_type_id;
+    win32_list_view_type_id = g_type_register_static (WIN32_TYPE_CONTROL, "Win32ListView", &g_define_type_info, 0);
+    return win32_list_view_type_id;
+}
+
+GType win32_list_view_get_type (void)
+{
+    static volatile gsize win32_list_view_type_id__volatile = 0;
+    if (g_once_init_enter (&win32_list_view_type_id__volatile)) {
+        GType win32_list_view_type_id;
+        win32_list_view_type_id = win32_list_view_get_type_once ();
+        g_once_init_leave (&win32_list_view_type_id__volatile, win32_list_view_type_id);
+    }
+    return win32_list_view_type_id__volatile;
+}
@@ -0,0 +1,87 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef _WIN32_LIST_VIEW_H_
+#define _WIN32_LIST_VIEW_H_
+
+#include <windows.h>
+#include <commctrl.h>
+#include <glib-object.h>
+#include "window.h"
+#include "control.h"
+
+typedef struct _Win32ListView Win32ListView;
+typedef struct _Win32ListViewClass Win32ListViewClass;
+
+// Returns the UTF-8 text of a cell, freed with g_free
+typedef char* (*Win32ListDataProvider) (int row, int column, void *boundData);
+// The rows the control is about to ask for, inclusive
+typedef void  (*Win32ListCacheHint) (int first, int last, void *boundData);
+
+#define WIN32_TYPE_LIST_VIEW (win32_list_view_get_type ())
+#define WIN32_LIST_VIEW(obj) (G_TYPE_CHECK_INSTANCE_CAST ((obj), WIN32_TYPE_LIST_VIEW, Win32ListView))
+#define WIN32_LIST_VIEW_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST ((klass), WIN32_TYPE_LIST_VIEW, Win32ListViewClass))
+#define WIN32_IS_LIST_VIEW(obj) (G_TYPE_CHECK_INSTANCE_TYPE ((obj), WIN32_TYPE_LIST_VIEW))
+#define WIN32_IS_LIST_VIEW_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass), WIN32_TYPE_LIST_VIEW))
+#define WIN32_LIST_VIEW_GET_CLASS(obj) (G_TYPE_INSTANCE_GET_CLASS ((obj), WIN32_TYPE_LIST_VIEW, Win32ListViewClass))
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (Win32ListView, win32_window_unref)
+
+/* STRUCT ListColumn
+------------------------------------------- */
+typedef struct _Win32ListColumn {
+    char *title;
+    int   width;
+} Win32ListColumn;
+
+/* CLASS ListView
+------------------------------------------- */
+// A report-style list view in virtual mode. Rows aren't stored, the control
+// asks the data provider for the cells it is about to paint.
+struct _Win32ListView {
+    Win32Control parent_instance;
+    Win32ListColumn *columns;
+    int numColumns;
+    int capacity;
+    int rowCount;
+
+    Win32ListDataProvider provider;
+    void *providerData;
+    Win32ReleaseFunction releaseProviderData;
+    Win32ListCacheHint cacheHint;
+    void *cacheHintData;
+    Win32ReleaseFunction releaseCacheHintData;
+
+    wchar_t *cellText;      // the last cell handed to the control, reused for every cell
+    size_t cellCapacity;
+};
+
+struct _Win32ListViewClass {
+    Win32ControlClass parent_class;
+};
+
+Win32ListView* win32_list_view_new (Win32Window* parent);
+
+void win32_list_view_add_column (Win32ListView *instance, const char *title, int width);
+
+void win32_list_view_set_row_count (Win32ListView *instance, int count);
+int  win32_list_view_get_row_count (Win32ListView *instance);
+
+void win32_list_view_set_data_provider (Win32ListView *instance,
+                                        Win32ListDataProvider provider,
+                                        void *boundData,
+                                        Win32ReleaseFunction releaseData);
+void win32_list_view_set_cache_hint (Win32ListView *instance,
+                                     Win32ListCacheHint hint,
+                                     void *boundData,
+                                     Win32ReleaseFunction releaseData);
+
+void win32_list_view_redraw_rows (Win32ListView *instance, int first, int last);
+
+/* INTERNAL */
+GType win32_list_view_get_type (void) G_GNUC_CONST;
+Win32ListView* win32_list_view_construct (GType object_type, Win32Window* parent);
+
+#endif
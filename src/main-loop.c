@@ -0,0 +1,357 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+
+/* CONSTRUCTOR
+------------------------------------------- */
+Win32MainLoop* win32_main_loop_new (void)
+{
+    Win32MainLoop *loop = malloc( sizeof(Win32MainLoop) );
+    memset( loop, 0, sizeof(Win32MainLoop) );
+    loop->context = g_main_context_ref (g_main_context_default ());
+    win32_main_loop_ref (loop);
+    return loop;
+}
+
+
+/* PROPERTY CONTEXT
+------------------------------------------- */
+GMainContext* win32_main_loop_get_context (Win32MainLoop *loop)
+{
+    return loop->context;
+}
+
+// The context is acquired while the loop runs, NULL leaves GLib out
+void win32_main_loop_set_context (Win32MainLoop *loop, GMainContext *context)
+{
+    if ( context != NULL ) g_main_context_ref (context);
+    if ( loop->context != NULL ) g_main_context_unref (loop->context);
+    loop->context = context;
+}
+
+
+/* METHOD ADD IDLE
+------------------------------------------- */
+// Returns a handle to remove the handler with, 0 on failure
+guint win32_main_loop_add_idle (Win32MainLoop *loop,
+                                int priority,
+                                Win32IdleFunction function,
+                                void *boundData,
+                                Win32ReleaseFunction releaseData)
+{
+    if ( loop->numIdles == loop->idleCapacity ){
+        size_t capacity = ( loop->idleCapacity > 0 ) ? loop->idleCapacity * 2 : INITIAL_QUEUE_SIZE;
+        Win32IdleHandler *idles = realloc( loop->idles, capacity * sizeof(Win32IdleHandler) );
+        if ( idles == NULL ) return 0;
+        loop->idles = idles;
+        loop->idleCapacity = capacity;
+    }
+
+    // After the handlers of the same priority
+    size_t position = loop->numIdles;
+    while ( position > 0 && loop->idles[position - 1].priority > priority ) position--;
+    memmove( &loop->idles[position + 1], &loop->idles[position], (loop->numIdles - position) * sizeof(Win32IdleHandler) );
+    loop->numIdles += 1;
+
+    Win32IdleHandler *handler = &loop->idles[position];
+    handler->id = ++loop->nextId;
+    handler->priority = priority;
+    handler->function = function;
+    handler->boundData = boundData;
+    handler->releaseData = releaseData;
+    handler->removed = FALSE;
+
+    return handler->id;
+}
+
+
+/* METHOD ADD HANDLE
+------------------------------------------- */
+// The function runs whenever the handle is signaled, it has to reset the
+// handle unless the handle resets itself. Returns 0 when MAIN_LOOP_MAX_HANDLES
+// are watched already.
+guint win32_main_loop_add_handle (Win32MainLoop *loop,
+                                  HANDLE handle,
+                                  Win32HandleFunction function,
+                                  void *boundData,
+                                  Win32ReleaseFunction releaseData)
+{
+    if ( loop->numHandles == MAIN_LOOP_MAX_HANDLES || handle == NULL ) return 0;
+
+    size_t index = loop->numHandles++;
+    Win32HandleWatch *watch = &loop->watches[index];
+    loop->handles[index] = handle;
+    watch->id = ++loop->nextId;
+    watch->function = function;
+    watch->boundData = boundData;
+    watch->releaseData = releaseData;
+    watch->removed = FALSE;
+
+    return watch->id;
+}
+
+
+/* INTERNAL COMPACT
+------------------------------------------- */
+// Releases the handlers removed while they were dispatched
+static void win32_main_loop_compact (Win32MainLoop *loop)
+{
+    if ( loop->dispatching > 0 ) return;
+
+    size_t kept = 0;
+    for (size_t i=0; i<loop->numIdles; i++){
+        Win32IdleHandler *handler = &loop->idles[i];
+        if ( handler->removed ){
+            if ( handler->releaseData != NULL ) handler->releaseData (handler->boundData);
+            continue;
+        }
+        loop->idles[kept++] = *handler;
+    }
+    loop->numIdles = kept;
+
+    kept = 0;
+    for (size_t i=0; i<loop->numHandles; i++){
+        Win32HandleWatch *watch = &loop->watches[i];
+        if ( watch->removed ){
+            if ( watch->releaseData != NULL ) watch->releaseData (watch->boundData);
+            continue;
+        }
+        loop->handles[kept] = loop->handles[i];
+        loop->watches[kept++] = *watch;
+    }
+    loop->numHandles = kept;
+}
+
+
+/* METHOD REMOVE
+------------------------------------------- */
+// Removes an idle handler or a handle watch
+BOOL win32_main_loop_remove (Win32MainLoop *loop, guint id)
+{
+    for (size_t i=0; i<loop->numIdles; i++){
+        if ( loop->idles[i].id != id || loop->idles[i].removed ) continue;
+        loop->idles[i].removed = TRUE;
+        win32_main_loop_compact (loop);
+        return TRUE;
+    }
+    for (size_t i=0; i<loop->numHandles; i++){
+        if ( loop->watches[i].id != id || loop->watches[i].removed ) continue;
+        loop->watches[i].removed = TRUE;
+        win32_main_loop_compact (loop);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+
+/* INTERNAL RUN IDLES
+------------------------------------------- */
+// Runs the idle handlers in priority order until a message arrives. Returns
+// TRUE when handlers are left to run again.
+static BOOL win32_main_loop_run_idles (Win32MainLoop *loop)
+{
+    if ( loop->numIdles == 0 ) return FALSE;
+
+    loop->dispatching += 1;
+    for (size_t i=0; i<loop->numIdles; i++){
+        if ( loop->idles[i].removed ) continue;
+
+        guint id = loop->idles[i].id;
+        if ( !loop->idles[i].function (loop->idles[i].boundData) ) loop->idles[i].removed = TRUE;
+        // Handlers added meanwhile may have moved this one further
+        while ( loop->idles[i].id != id ) i++;
+
+        if ( HIWORD (GetQueueStatus (QS_ALLINPUT)) != 0 ) break;
+    }
+    loop->dispatching -= 1;
+
+    win32_main_loop_compact (loop);
+    return loop->numIdles > 0;
+}
+
+
+/* INTERNAL DISPATCH HANDLE
+------------------------------------------- */
+static void win32_main_loop_dispatch_handle (Win32MainLoop *loop, guint id)
+{
+    for (size_t i=0; i<loop->numHandles; i++){
+        Win32HandleWatch *watch = &loop->watches[i];
+        if ( watch->id != id ) continue;
+        if ( watch->removed ) return;
+
+        loop->dispatching += 1;
+        if ( !watch->function (loop->handles[i], watch->boundData) ) watch->removed = TRUE;
+        loop->dispatching -= 1;
+
+        win32_main_loop_compact (loop);
+        return;
+    }
+}
+
+
+/* INTERNAL QUERY
+------------------------------------------- */
+// Prepares the context and collects its handles. Returns the number of
+// GLib handles, the timeout is lowered to what the context allows.
+static gint win32_main_loop_query (Win32MainLoop *loop, GMainContext *context, gint *priority, gint *timeout)
+{
+    gint glibTimeout;
+    if ( g_main_context_prepare (context, priority) ) *timeout = 0;
+
+    gint numFds = g_main_context_query (context, *priority, &glibTimeout, loop->fds, loop->fdCapacity);
+    if ( numFds > loop->fdCapacity ){
+        GPollFD *fds = realloc( loop->fds, numFds * sizeof(GPollFD) );
+        if ( fds == NULL ) return 0;
+        loop->fds = fds;
+        loop->fdCapacity = numFds;
+        numFds = g_main_context_query (context, *priority, &glibTimeout, loop->fds, loop->fdCapacity);
+    }
+
+    if ( glibTimeout >= 0 && (*timeout < 0 || glibTimeout < *timeout) ) *timeout = glibTimeout;
+    return numFds;
+}
+
+
+/* INTERNAL WAIT
+------------------------------------------- */
+// Sleeps until a message, a watched handle, a GLib source or an APC is
+// ready, then dispatches the handle and the GLib sources
+static void win32_main_loop_wait (Win32MainLoop *loop, GMainContext *context, BOOL busy)
+{
+    HANDLE handles[MAIN_LOOP_MAX_HANDLES];
+    gint slotFd[MAIN_LOOP_MAX_HANDLES];      // the GLib handle a slot holds, -1 for watches
+    DWORD count = 0;
+    gint timeout = busy ? 0 : -1;
+    gint priority = 0;
+    gint numFds = 0;
+    BOOL truncated = FALSE;
+
+    for (size_t i=0; i<loop->numHandles; i++){
+        handles[count] = loop->handles[i];
+        slotFd[count++] = -1;
+    }
+
+    if ( context != NULL ){
+        numFds = win32_main_loop_query (loop, context, &priority, &timeout);
+        for (gint i=0; i<numFds; i++){
+            loop->fds[i].revents = 0;
+            // Messages are the loop's own business
+            if ( loop->fds[i].fd == G_WIN32_MSG_HANDLE ) continue;
+            if ( count == MAIN_LOOP_MAX_HANDLES ){
+                truncated = TRUE;
+                continue;
+            }
+            handles[count] = (HANDLE) (gintptr) loop->fds[i].fd;
+            slotFd[count++] = i;
+        }
+    }
+    if ( truncated && (timeout < 0 || timeout > MAIN_LOOP_POLL_INTERVAL) ) timeout = MAIN_LOOP_POLL_INTERVAL;
+
+    DWORD result = MsgWaitForMultipleObjectsEx (count, handles, ( timeout < 0 ) ? INFINITE : (DWORD) timeout,
+                                                QS_ALLINPUT, MWMO_INPUTAVAILABLE | MWMO_ALERTABLE);
+    DWORD slot = count;
+    if ( result < WAIT_OBJECT_0 + count ) slot = result - WAIT_OBJECT_0;
+    else if ( result >= WAIT_ABANDONED_0 && result < WAIT_ABANDONED_0 + count ) slot = result - WAIT_ABANDONED_0;
+    // Messages, completion routines and timeouts only get the GLib sources checked
+
+    // The watch is looked up again by id, GLib callbacks may remove watches
+    guint watchId = 0;
+    if ( slot < count && slotFd[slot] < 0 ) watchId = loop->watches[slot].id;
+
+    if ( context != NULL ){
+        // Only one handle is reported by the wait, the others are polled
+        for (gint i=0; i<numFds; i++){
+            HANDLE handle = (HANDLE) (gintptr) loop->fds[i].fd;
+            if ( loop->fds[i].fd == G_WIN32_MSG_HANDLE ) continue;
+            if ( (slot < count && slotFd[slot] == i) || WaitForSingleObject (handle, 0) == WAIT_OBJECT_0 ){
+                loop->fds[i].revents = loop->fds[i].events;
+            }
+        }
+        if ( g_main_context_check (context, priority, loop->fds, numFds) ) g_main_context_dispatch (context);
+    }
+
+    if ( watchId != 0 ) win32_main_loop_dispatch_handle (loop, watchId);
+}
+
+
+/* METHOD RUN
+------------------------------------------- */
+// Runs until WM_QUIT, returns its exit code
+int win32_main_loop_run (Win32MainLoop *loop)
+{
+    MSG msg;
+    int exitCode = 0;
+    win32_main_loop_ref (loop);
+
+    // Another thread iterating the context keeps its sources to itself
+    GMainContext *context = loop->context;
+    if ( context != NULL && !g_main_context_acquire (context) ) context = NULL;
+    else if ( context != NULL ) g_main_context_ref (context);
+
+    for (;;){
+        BOOL quit = FALSE;
+        while ( PeekMessage (&msg, NULL, 0, 0, PM_REMOVE) ){
+            if ( msg.message == WM_QUIT ){
+                quit = TRUE;
+                exitCode = (int) msg.wParam;
+                break;
+            }
+            WIN32_PROFILE_QUEUE_WAIT (&msg);
+            TranslateMessage (&msg);
+            DispatchMessage (&msg);
+        }
+        if ( quit ) break;
+
+        // With idle handlers left, only look whether something is ready
+        BOOL busy = win32_main_loop_run_idles (loop);
+        win32_main_loop_wait (loop, context, busy);
+    }
+
+    if ( context != NULL ){
+        g_main_context_release (context);
+        g_main_context_unref (context);
+    }
+    win32_main_loop_unref (loop);
+    return exitCode;
+}
+
+
+/* METHOD QUIT
+------------------------------------------- */
+// Has to be called on the thread the loop runs on
+void win32_main_loop_quit (Win32MainLoop *loop, int exitCode)
+{
+    PostQuitMessage (exitCode);
+}
+
+
+/* INTERNAL REF MAIN LOOP
+------------------------------------------- */
+void* win32_main_loop_ref (void* instance)
+{
+    Win32MainLoop * self = instance;
+    WIN32_REF_INC (self->ref_count);
+    return self;
+}
+
+
+/* INTERNAL UNREF MAIN LOOP
+------------------------------------------- */
+void win32_main_loop_unref (void* instance)
+{
+    Win32MainLoop * self = instance;
+    if (WIN32_REF_DEC_AND_TEST (self->ref_count)) {
+        for (size_t i=0; i<self->numIdles; i++) self->idles[i].removed = TRUE;
+        for (size_t i=0; i<self->numHandles; i++) self->watches[i].removed = TRUE;
+        self->dispatching = 0;
+        win32_main_loop_compact (self);
+        if ( self->context != NULL ) g_main_context_unref (self->context);
+        free (self->fds);
+        free (self->idles);
+        free (self);
+    }
+}
@@ -0,0 +1,94 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_MAIN_LOOP_H
+#define WIN32_MAIN_LOOP_H
+
+#include <windows.h>
+#include <glib.h>
+
+#define MAIN_LOOP_PRIORITY_HIGH     -100  // idle handlers with a lower value run first
+#define MAIN_LOOP_PRIORITY_DEFAULT     0
+#define MAIN_LOOP_PRIORITY_LOW       100
+
+#define MAIN_LOOP_MAX_HANDLES  (MAXIMUM_WAIT_OBJECTS - 1)  // one slot is the message queue's
+#define MAIN_LOOP_POLL_INTERVAL  10   // ms, GLib handles that don't fit in the wait are polled this often
+
+// Return FALSE to be removed
+typedef gboolean (*Win32IdleFunction) (void *boundData);
+typedef gboolean (*Win32HandleFunction) (HANDLE handle, void *boundData);
+
+/* STRUCT IdleHandler
+------------------------------------------- */
+typedef struct _Win32IdleHandler {
+    guint id;
+    int priority;
+    Win32IdleFunction function;
+    void *boundData;
+    Win32ReleaseFunction releaseData;
+    BOOL removed;
+} Win32IdleHandler;
+
+/* STRUCT HandleWatch
+------------------------------------------- */
+typedef struct _Win32HandleWatch {
+    guint id;
+    Win32HandleFunction function;
+    void *boundData;
+    Win32ReleaseFunction releaseData;
+    BOOL removed;
+} Win32HandleWatch;
+
+/* STRUCT MainLoop (REF COUNTED)
+------------------------------------------- */
+// Dispatches the messages of the thread it runs on. When the queue is empty
+// the idle handlers run in priority order, as long as no message arrives.
+// With nothing left to do it sleeps until a message, a watched handle or an
+// APC wakes it up. The GLib sources of its context are waited on in the same
+// call and dispatched between message batches, so async methods and GIO
+// complete on the UI thread.
+typedef struct _Win32MainLoop {
+    volatile int ref_count;
+
+    Win32IdleHandler *idles;        // sorted by priority, handlers of the same priority in the order added
+    size_t numIdles;
+    size_t idleCapacity;
+
+    HANDLE handles[MAIN_LOOP_MAX_HANDLES];
+    Win32HandleWatch watches[MAIN_LOOP_MAX_HANDLES];
+    size_t numHandles;
+
+    GMainContext *context;          // the default context unless set otherwise, may be NULL
+    GPollFD *fds;                   // queried from the context on every wait
+    gint fdCapacity;
+
+    guint nextId;
+    int dispatching;                // handlers removed meanwhile are compacted afterwards
+} Win32MainLoop;
+
+Win32MainLoop* win32_main_loop_new (void);
+
+guint win32_main_loop_add_idle (Win32MainLoop *loop,
+                                int priority,
+                                Win32IdleFunction function,
+                                void *boundData,
+                                Win32ReleaseFunction releaseData);
+guint win32_main_loop_add_handle (Win32MainLoop *loop,
+                                  HANDLE handle,
+                                  Win32HandleFunction function,
+                                  void *boundData,
+                                  Win32ReleaseFunction releaseData);
+BOOL  win32_main_loop_remove (Win32MainLoop *loop, guint id);
+
+GMainContext* win32_main_loop_get_context (Win32MainLoop *loop);
+void  win32_main_loop_set_context (Win32MainLoop *loop, GMainContext *context);
+
+int   win32_main_loop_run  (Win32MainLoop *loop);
+void  win32_main_loop_quit (Win32MainLoop *loop, int exitCode);
+
+void* win32_main_loop_ref   (void*);
+void  win32_main_loop_unref (void*);
+
+#endif
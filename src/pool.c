@@ -0,0 +1,81 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+// Size classes are multiples of the pointer size, large enough to link objects
+#define SIZE_CLASS(size) (((size) + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*))
+
+Win32Pool win32_pools[WIN32_NUM_POOLS] = {
+    { "Anchor",     SIZE_CLASS(sizeof(Win32Anchor)) },
+    { "LayoutData", SIZE_CLASS(sizeof(Win32LayoutData)) },
+};
+
+#ifndef WIN32_SINGLE_THREADED
+G_LOCK_DEFINE_STATIC (pools);
+#define POOL_LOCK()    G_LOCK (pools)
+#define POOL_UNLOCK()  G_UNLOCK (pools)
+#else
+#define POOL_LOCK()
+#define POOL_UNLOCK()
+#endif
+
+
+/* INTERNAL GROW
+------------------------------------------- */
+// Carves a new slab into objects and puts them on the free list. The first
+// object of the slab is kept to link the slabs together.
+static BOOL win32_pool_grow (Win32Pool *pool)
+{
+    char *slab = malloc( pool->objectSize * (POOL_SLAB_OBJECTS + 1) );
+    if ( slab == NULL ) return FALSE;
+
+    *(void**) slab = pool->slabs;
+    pool->slabs = slab;
+    pool->numSlabs += 1;
+
+    for (int i=POOL_SLAB_OBJECTS; i>=1; i--){
+        void *object = slab + i * pool->objectSize;
+        *(void**) object = pool->freeList;
+        pool->freeList = object;
+    }
+    return TRUE;
+}
+
+
+/* METHOD ALLOC
+------------------------------------------- */
+// Returns a zeroed object of the type, NULL when out of memory
+void* win32_pool_alloc (Win32PoolType type)
+{
+    Win32Pool *pool = &win32_pools[type];
+    void *object = NULL;
+
+    POOL_LOCK ();
+    if ( pool->freeList != NULL || win32_pool_grow (pool) ){
+        object = pool->freeList;
+        pool->freeList = *(void**) object;
+        pool->numAllocations += 1;
+    }
+    POOL_UNLOCK ();
+
+    if ( object != NULL ) memset( object, 0, pool->objectSize );
+    return object;
+}
+
+
+/* METHOD FREE
+------------------------------------------- */
+void win32_pool_free (Win32PoolType type, void *object)
+{
+    Win32Pool *pool = &win32_pools[type];
+    if ( object == NULL ) return;
+
+    POOL_LOCK ();
+    *(void**) object = pool->freeList;
+    pool->freeList = object;
+    pool->numFrees += 1;
+    POOL_UNLOCK ();
+}
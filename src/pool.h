@@ -0,0 +1,53 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_POOL_H
+#define WIN32_POOL_H
+
+#include <windows.h>
+#include <glib.h>
+
+#define POOL_SLAB_OBJECTS  64   // objects carved out of every slab
+
+/* REFERENCE COUNTS
+------------------------------------------- */
+// The library objects are refcounted atomically. Applications that only touch
+// them from the UI thread can build with -DWIN32_SINGLE_THREADED for plain
+// increments; the pools drop their lock as well. Tasks and invoke_async hand
+// windows to other threads, they need the atomic build.
+#ifdef WIN32_SINGLE_THREADED
+#define WIN32_REF_INC(counter)          ((void) ++(counter))
+#define WIN32_REF_DEC_AND_TEST(counter) (--(counter) == 0)
+#else
+#define WIN32_REF_INC(counter)          g_atomic_int_inc (&(counter))
+#define WIN32_REF_DEC_AND_TEST(counter) g_atomic_int_dec_and_test (&(counter))
+#endif
+
+/* SLAB POOLS
+------------------------------------------- */
+// Small fixed-size objects come from per-type pools instead of malloc. Slabs
+// are kept for the lifetime of the process, freed objects are reused.
+typedef enum {
+    WIN32_POOL_ANCHOR,
+    WIN32_POOL_LAYOUT_DATA,
+    WIN32_NUM_POOLS
+} Win32PoolType;
+
+typedef struct _Win32Pool {
+    const char *name;
+    size_t objectSize;      // rounded up to the size class
+    void  *freeList;        // the first word of a free object links the next one
+    void  *slabs;           // the first object of a slab links the previous slab
+    gulong numAllocations;
+    gulong numFrees;
+    gulong numSlabs;
+} Win32Pool;
+
+extern Win32Pool win32_pools[WIN32_NUM_POOLS];
+
+void* win32_pool_alloc (Win32PoolType type);
+void  win32_pool_free  (Win32PoolType type, void *object);
+
+#endif
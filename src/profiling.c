@@ -0,0 +1,248 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+static const char *timerNames[WIN32_NUM_TIMERS] = {
+    "message",
+    "callback",
+    "layout",
+    "queue wait",
+};
+
+#ifdef WIN32_PROFILING
+static Win32Timer timers[WIN32_NUM_TIMERS] = { 0 };
+static gulong messageCounts[WIN32_PROFILE_MESSAGES] = { 0 };
+static guint64 messageTicks[WIN32_PROFILE_MESSAGES] = { 0 };
+static guint64 frequency = 0;
+
+static guint64 win32_profiling_frequency (void)
+{
+    if ( frequency == 0 ){
+        LARGE_INTEGER value;
+        QueryPerformanceFrequency (&value);
+        frequency = value.QuadPart;
+    }
+    return frequency;
+}
+
+static double ticks_to_ms (guint64 ticks)
+{
+    return (double) ticks * 1e3 / win32_profiling_frequency ();
+}
+
+
+/* INTERNAL ADD SAMPLE
+------------------------------------------- */
+static void win32_timer_add (Win32Timer *timer, guint64 ticks)
+{
+    guint64 us = ticks * 1000000 / win32_profiling_frequency ();
+    int bucket = 0;
+    while ( us > 0 && bucket < WIN32_PROFILE_BUCKETS - 1 ){
+        us >>= 1;
+        bucket++;
+    }
+
+    timer->count += 1;
+    timer->total += ticks;
+    if ( ticks > timer->max ) timer->max = ticks;
+    timer->buckets[bucket] += 1;
+}
+
+
+/* INTERNAL RECORD
+------------------------------------------- */
+void win32_profiling_record (Win32TimerType timer, LARGE_INTEGER *start)
+{
+    LARGE_INTEGER end;
+    QueryPerformanceCounter (&end);
+    win32_timer_add (&timers[timer], end.QuadPart - start->QuadPart);
+}
+
+
+/* INTERNAL RECORD MESSAGE
+------------------------------------------- */
+// Passes the result of the window procedure through
+LRESULT win32_profiling_record_message (UINT msg, LARGE_INTEGER *start, LRESULT result)
+{
+    LARGE_INTEGER end;
+    QueryPerformanceCounter (&end);
+    guint64 ticks = end.QuadPart - start->QuadPart;
+
+    win32_timer_add (&timers[WIN32_TIMER_MESSAGE], ticks);
+    messageCounts[msg & 0xFFFF] += 1;
+    messageTicks[msg & 0xFFFF] += ticks;
+    return result;
+}
+
+
+/* INTERNAL RECORD QUEUE WAIT
+------------------------------------------- */
+// The message time is the tick count it was posted at
+void win32_profiling_record_queue_wait (const MSG *msg)
+{
+    LONG waited = (LONG) (GetTickCount () - msg->time);
+    if ( waited < 0 ) return;
+    win32_timer_add (&timers[WIN32_TIMER_QUEUE_WAIT], (guint64) waited * win32_profiling_frequency () / 1000);
+}
+#endif
+
+
+/* METHOD IS ENABLED
+------------------------------------------- */
+gboolean win32_profiling_is_enabled (void)
+{
+#ifdef WIN32_PROFILING
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
+
+
+/* METHOD GET MESSAGE COUNT
+------------------------------------------- */
+gulong win32_profiling_get_message_count (UINT msg)
+{
+#ifdef WIN32_PROFILING
+    if ( msg < WIN32_PROFILE_MESSAGES ) return messageCounts[msg];
+#endif
+    return 0;
+}
+
+
+/* METHOD GET MESSAGE TIME
+------------------------------------------- */
+// Milliseconds spent on the message in total
+double win32_profiling_get_message_time (UINT msg)
+{
+#ifdef WIN32_PROFILING
+    if ( msg < WIN32_PROFILE_MESSAGES ) return ticks_to_ms (messageTicks[msg]);
+#endif
+    return 0;
+}
+
+
+/* METHOD GET TIMER NAME
+------------------------------------------- */
+const char* win32_profiling_get_timer_name (Win32TimerType timer)
+{
+    if ( timer < 0 || timer >= WIN32_NUM_TIMERS ) return NULL;
+    return timerNames[timer];
+}
+
+
+/* METHOD GET TIMER COUNT
+------------------------------------------- */
+gulong win32_profiling_get_timer_count (Win32TimerType timer)
+{
+#ifdef WIN32_PROFILING
+    if ( timer >= 0 && timer < WIN32_NUM_TIMERS ) return timers[timer].count;
+#endif
+    return 0;
+}
+
+
+/* METHOD GET TIMER TOTAL
+------------------------------------------- */
+// Milliseconds
+double win32_profiling_get_timer_total (Win32TimerType timer)
+{
+#ifdef WIN32_PROFILING
+    if ( timer >= 0 && timer < WIN32_NUM_TIMERS ) return ticks_to_ms (timers[timer].total);
+#endif
+    return 0;
+}
+
+
+/* METHOD GET TIMER MAX
+------------------------------------------- */
+// Milliseconds
+double win32_profiling_get_timer_max (Win32TimerType timer)
+{
+#ifdef WIN32_PROFILING
+    if ( timer >= 0 && timer < WIN32_NUM_TIMERS ) return ticks_to_ms (timers[timer].max);
+#endif
+    return 0;
+}
+
+
+/* METHOD GET TIMER BUCKET
+------------------------------------------- */
+// Samples shorter than the limit of the bucket and not shorter than the one before
+gulong win32_profiling_get_timer_bucket (Win32TimerType timer, int bucket)
+{
+#ifdef WIN32_PROFILING
+    if ( timer < 0 || timer >= WIN32_NUM_TIMERS ) return 0;
+    if ( bucket >= 0 && bucket < WIN32_PROFILE_BUCKETS ) return timers[timer].buckets[bucket];
+#endif
+    return 0;
+}
+
+
+/* METHOD GET BUCKET LIMIT
+------------------------------------------- */
+// Milliseconds, -1 for the last bucket which has none
+double win32_profiling_get_bucket_limit (int bucket)
+{
+    if ( bucket < 0 || bucket >= WIN32_PROFILE_BUCKETS - 1 ) return -1;
+    return (double) (1 << bucket) / 1e3;
+}
+
+
+/* METHOD DUMP
+------------------------------------------- */
+// Writes the counters as text. Returns FALSE if the file can't be written or
+// the library is built without profiling.
+BOOL win32_profiling_dump (const char *filename)
+{
+#ifdef WIN32_PROFILING
+    Win32WideString path;
+    FILE *file = _wfopen (win32_wide_string_init (&path, filename), L"w");
+    win32_wide_string_release (&path);
+    if ( file == NULL ) return FALSE;
+
+    fprintf (file, "%-12s %10s %12s %10s %10s\n", "timer", "count", "total ms", "mean ms", "max ms");
+    for (int i=0; i<WIN32_NUM_TIMERS; i++){
+        Win32Timer *timer = &timers[i];
+        double total = ticks_to_ms (timer->total);
+        fprintf (file, "%-12s %10lu %12.3f %10.4f %10.3f\n", timerNames[i], timer->count, total,
+                 ( timer->count > 0 ) ? total / timer->count : 0, ticks_to_ms (timer->max));
+    }
+
+    for (int i=0; i<WIN32_NUM_TIMERS; i++){
+        if ( timers[i].count == 0 ) continue;
+        fprintf (file, "\n%s\n", timerNames[i]);
+        for (int bucket=0; bucket<WIN32_PROFILE_BUCKETS; bucket++){
+            if ( timers[i].buckets[bucket] == 0 ) continue;
+            double limit = win32_profiling_get_bucket_limit (bucket);
+            if ( limit < 0 ) fprintf (file, "    %12s %10lu\n", "longer", timers[i].buckets[bucket]);
+            else fprintf (file, "    < %9.3f ms %10lu\n", limit, timers[i].buckets[bucket]);
+        }
+    }
+
+    fprintf (file, "\n%-12s %10s %12s\n", "message", "count", "total ms");
+    for (UINT msg=0; msg<WIN32_PROFILE_MESSAGES; msg++){
+        if ( messageCounts[msg] == 0 ) continue;
+        fprintf (file, "0x%04X       %10lu %12.3f\n", msg, messageCounts[msg], ticks_to_ms (messageTicks[msg]));
+    }
+
+    return fclose (file) == 0;
+#else
+    return FALSE;
+#endif
+}
+
+
+/* METHOD RESET
+------------------------------------------- */
+void win32_profiling_reset (void)
+{
+#ifdef WIN32_PROFILING
+    memset( timers, 0, sizeof(timers) );
+    memset( messageCounts, 0, sizeof(messageCounts) );
+    memset( messageTicks, 0, sizeof(messageTicks) );
+#endif
+}
@@ -0,0 +1,67 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_PROFILING_H
+#define WIN32_PROFILING_H
+
+#include <windows.h>
+#include <glib.h>
+
+#define WIN32_PROFILE_BUCKETS   24        // bucket n holds durations below 2^n µs, the last one the rest
+#define WIN32_PROFILE_MESSAGES  0x10000   // every message ID has its own counters
+
+/* TIMERS
+------------------------------------------- */
+// Where the UI thread spends its time. Messages are timed through the window
+// procedures, nested messages are included in the time of the outer one.
+typedef enum {
+    WIN32_TIMER_MESSAGE,        // a message through a window procedure
+    WIN32_TIMER_CALLBACK,       // a listener callback
+    WIN32_TIMER_LAYOUT,         // a layout recalculation
+    WIN32_TIMER_QUEUE_WAIT,     // a message waiting in the queue, millisecond resolution
+    WIN32_NUM_TIMERS
+} Win32TimerType;
+
+typedef struct _Win32Timer {
+    gulong count;
+    guint64 total;                              // performance counter ticks
+    guint64 max;
+    gulong buckets[WIN32_PROFILE_BUCKETS];
+} Win32Timer;
+
+/* INSTRUMENTATION
+------------------------------------------- */
+// Compiled in with -DWIN32_PROFILING only, otherwise the macros expand to
+// nothing and the queries below return zeros. Recording is not thread safe,
+// the instrumented code runs on the UI thread.
+#ifdef WIN32_PROFILING
+#define WIN32_PROFILE_BEGIN(start)                   LARGE_INTEGER start; QueryPerformanceCounter (&start)
+#define WIN32_PROFILE_END(timer, start)              win32_profiling_record (timer, &start)
+#define WIN32_PROFILE_MESSAGE(msg, start, result)    win32_profiling_record_message (msg, &start, result)
+#define WIN32_PROFILE_QUEUE_WAIT(msg)                win32_profiling_record_queue_wait (msg)
+
+void    win32_profiling_record (Win32TimerType timer, LARGE_INTEGER *start);
+LRESULT win32_profiling_record_message (UINT msg, LARGE_INTEGER *start, LRESULT result);
+void    win32_profiling_record_queue_wait (const MSG *msg);
+#else
+#define WIN32_PROFILE_BEGIN(start)                   ((void) 0)
+#define WIN32_PROFILE_END(timer, start)              ((void) 0)
+#define WIN32_PROFILE_MESSAGE(msg, start, result)    (result)
+#define WIN32_PROFILE_QUEUE_WAIT(msg)                ((void) 0)
+#endif
+
+gboolean    win32_profiling_is_enabled (void);
+gulong      win32_profiling_get_message_count (UINT msg);
+double      win32_profiling_get_message_time (UINT msg);
+const char* win32_profiling_get_timer_name (Win32TimerType timer);
+gulong      win32_profiling_get_timer_count (Win32TimerType timer);
+double      win32_profiling_get_timer_total (Win32TimerType timer);
+double      win32_profiling_get_timer_max (Win32TimerType timer);
+gulong      win32_profiling_get_timer_bucket (Win32TimerType timer, int bucket);
+double      win32_profiling_get_bucket_limit (int bucket);
+BOOL        win32_profiling_dump (const char *filename);
+void        win32_profiling_reset (void);
+
+#endif
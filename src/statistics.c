@@ -0,0 +1,131 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+gulong win32_call_counters[WIN32_NUM_CALLS] = { 0 };
+gulong win32_cache_counters[WIN32_NUM_CACHE_COUNTERS] = { 0 };
+
+static const char *callNames[WIN32_NUM_CALLS] = {
+    "GetClientRect",
+    "GetWindowRect",
+    "MapWindowPoints",
+    "SetWindowPos",
+    "DeferWindowPos",
+    "WM_SETREDRAW",
+    "RedrawWindow",
+    "GetWindowTextLength",
+    "GetWindowText",
+    "GetTextExtentPoint32",
+};
+
+static const char *cacheNames[WIN32_NUM_CACHE_COUNTERS] = {
+    "text hits",
+    "text misses",
+    "text extent hits",
+    "text extent misses",
+};
+
+
+/* METHOD GET CALL COUNT
+------------------------------------------- */
+gulong win32_statistics_get_call_count (Win32CallType call)
+{
+    if ( call < 0 || call >= WIN32_NUM_CALLS ) return 0;
+    return win32_call_counters[call];
+}
+
+
+/* METHOD GET CALL NAME
+------------------------------------------- */
+const char* win32_statistics_get_call_name (Win32CallType call)
+{
+    if ( call < 0 || call >= WIN32_NUM_CALLS ) return NULL;
+    return callNames[call];
+}
+
+
+/* METHOD GET TOTAL CALLS
+------------------------------------------- */
+gulong win32_statistics_get_total_calls (void)
+{
+    gulong total = 0;
+    for (int i=0; i<WIN32_NUM_CALLS; i++) total += win32_call_counters[i];
+    return total;
+}
+
+
+/* METHOD GET CACHE COUNT
+------------------------------------------- */
+gulong win32_statistics_get_cache_count (Win32CacheCounter counter)
+{
+    if ( counter < 0 || counter >= WIN32_NUM_CACHE_COUNTERS ) return 0;
+    return win32_cache_counters[counter];
+}
+
+
+/* METHOD GET CACHE NAME
+------------------------------------------- */
+const char* win32_statistics_get_cache_name (Win32CacheCounter counter)
+{
+    if ( counter < 0 || counter >= WIN32_NUM_CACHE_COUNTERS ) return NULL;
+    return cacheNames[counter];
+}
+
+
+/* METHOD GET POOL NAME
+------------------------------------------- */
+const char* win32_statistics_get_pool_name (Win32PoolType type)
+{
+    if ( type < 0 || type >= WIN32_NUM_POOLS ) return NULL;
+    return win32_pools[type].name;
+}
+
+
+/* METHOD GET POOL ALLOCATIONS
+------------------------------------------- */
+gulong win32_statistics_get_pool_allocations (Win32PoolType type)
+{
+    if ( type < 0 || type >= WIN32_NUM_POOLS ) return 0;
+    return win32_pools[type].numAllocations;
+}
+
+
+/* METHOD GET POOL FREES
+------------------------------------------- */
+gulong win32_statistics_get_pool_frees (Win32PoolType type)
+{
+    if ( type < 0 || type >= WIN32_NUM_POOLS ) return 0;
+    return win32_pools[type].numFrees;
+}
+
+
+/* METHOD GET POOL LIVE
+------------------------------------------- */
+// Objects allocated and not yet freed
+gulong win32_statistics_get_pool_live (Win32PoolType type)
+{
+    if ( type < 0 || type >= WIN32_NUM_POOLS ) return 0;
+    return win32_pools[type].numAllocations - win32_pools[type].numFrees;
+}
+
+
+/* METHOD GET POOL SLABS
+------------------------------------------- */
+gulong win32_statistics_get_pool_slabs (Win32PoolType type)
+{
+    if ( type < 0 || type >= WIN32_NUM_POOLS ) return 0;
+    return win32_pools[type].numSlabs;
+}
+
+
+/* METHOD RESET
+------------------------------------------- */
+// The pool counters are left alone, the live objects are still out there
+void win32_statistics_reset (void)
+{
+    memset( win32_call_counters, 0, sizeof(win32_call_counters) );
+    memset( win32_cache_counters, 0, sizeof(win32_cache_counters) );
+}
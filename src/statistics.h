@@ -0,0 +1,62 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_STATISTICS_H
+#define WIN32_STATISTICS_H
+
+#include <windows.h>
+#include <glib.h>
+#include "pool.h"
+
+/* CALL COUNTERS
+------------------------------------------- */
+// Counters of the USER32 calls the library makes on behalf of the application.
+// They're always on, an increment is negligible next to the call it counts.
+typedef enum {
+    WIN32_CALL_GET_CLIENT_RECT,
+    WIN32_CALL_GET_WINDOW_RECT,
+    WIN32_CALL_MAP_WINDOW_POINTS,
+    WIN32_CALL_SET_WINDOW_POS,
+    WIN32_CALL_DEFER_WINDOW_POS,
+    WIN32_CALL_SET_REDRAW,
+    WIN32_CALL_REDRAW_WINDOW,
+    WIN32_CALL_GET_WINDOW_TEXT_LENGTH,
+    WIN32_CALL_GET_WINDOW_TEXT,
+    WIN32_CALL_GET_TEXT_EXTENT,
+    WIN32_NUM_CALLS
+} Win32CallType;
+
+extern gulong win32_call_counters[WIN32_NUM_CALLS];
+
+#define WIN32_COUNT_CALL(call)  (win32_call_counters[call] += 1)
+
+/* CACHE COUNTERS
+------------------------------------------- */
+// Hits and misses of the caches that save the calls above
+typedef enum {
+    WIN32_CACHE_TEXT_HIT,
+    WIN32_CACHE_TEXT_MISS,
+    WIN32_CACHE_TEXT_EXTENT_HIT,
+    WIN32_CACHE_TEXT_EXTENT_MISS,
+    WIN32_NUM_CACHE_COUNTERS
+} Win32CacheCounter;
+
+extern gulong win32_cache_counters[WIN32_NUM_CACHE_COUNTERS];
+
+#define WIN32_COUNT_CACHE(counter)  (win32_cache_counters[counter] += 1)
+
+gulong win32_statistics_get_call_count (Win32CallType call);
+const char* win32_statistics_get_call_name (Win32CallType call);
+gulong win32_statistics_get_total_calls (void);
+gulong win32_statistics_get_cache_count (Win32CacheCounter counter);
+const char* win32_statistics_get_cache_name (Win32CacheCounter counter);
+const char* win32_statistics_get_pool_name (Win32PoolType type);
+gulong win32_statistics_get_pool_allocations (Win32PoolType type);
+gulong win32_statistics_get_pool_frees (Win32PoolType type);
+gulong win32_statistics_get_pool_live (Win32PoolType type);
+gulong win32_statistics_get_pool_slabs (Win32PoolType type);
+void   win32_statistics_reset (void);
+
+#endif
@@ -0,0 +1,182 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+UINT win32_task_message = 0;
+static GThreadPool *g_workers = NULL;   // one thread per processor, created with the first task
+
+static void win32_task_execute (gpointer data, gpointer userData);
+
+
+/* CONSTRUCTOR
+------------------------------------------- */
+// The task isn't started until win32_task_start, so that the callbacks can be
+// set first. Has to be called on the thread of the window.
+Win32Task* win32_task_new (Win32Window *window, Win32TaskFunction work, void *boundData, Win32ReleaseFunction releaseData)
+{
+    Win32Task *task = malloc( sizeof(Win32Task) );
+    memset( task, 0, sizeof(Win32Task) );
+    task->ref_count = 1;
+    task->window = win32_window_ref (window);
+    task->dispatcher = win32_dispatcher_get ();
+    task->work = work;
+    task->workData = boundData;
+    task->releaseWorkData = releaseData;
+
+    if ( win32_task_message == 0 ) win32_task_message = RegisterWindowMessage (L"Win32TaskMessage");
+
+    return task;
+}
+
+
+/* METHOD ON DONE
+------------------------------------------- */
+// Called when the work function returns, a cancelled task completes as well
+void win32_task_on_done (Win32Task *task, Win32TaskCallback callback, void *boundData, Win32ReleaseFunction releaseData)
+{
+    if ( task->releaseDoneData != NULL ) task->releaseDoneData (task->doneData);
+    task->done = callback;
+    task->doneData = boundData;
+    task->releaseDoneData = releaseData;
+}
+
+
+/* METHOD ON PROGRESS
+------------------------------------------- */
+void win32_task_on_progress (Win32Task *task, Win32ProgressCallback callback, void *boundData, Win32ReleaseFunction releaseData)
+{
+    if ( task->releaseProgressData != NULL ) task->releaseProgressData (task->progressData);
+    task->progress = callback;
+    task->progressData = boundData;
+    task->releaseProgressData = releaseData;
+}
+
+
+/* METHOD START
+------------------------------------------- */
+// Queues the task for the worker threads. A task runs once, FALSE when it was
+// started before.
+BOOL win32_task_start (Win32Task *task)
+{
+    if ( !g_atomic_int_compare_and_exchange (&task->started, 0, 1) ) return FALSE;
+
+    if ( g_workers == NULL ){
+        g_workers = g_thread_pool_new (win32_task_execute, NULL, g_get_num_processors (), FALSE, NULL);
+    }
+
+    // The pool holds a reference until the completion is posted
+    win32_task_ref (task);
+    g_thread_pool_push (g_workers, task, NULL);
+    return TRUE;
+}
+
+
+/* METHOD CANCEL
+------------------------------------------- */
+// The work function stops when it next checks, a task that hasn't run yet
+// doesn't run at all. Progress isn't delivered after cancellation.
+void win32_task_cancel (Win32Task *task)
+{
+    g_atomic_int_set (&task->cancelled, 1);
+}
+
+
+/* METHOD IS CANCELLED
+------------------------------------------- */
+BOOL win32_task_is_cancelled (Win32Task *task)
+{
+    return g_atomic_int_get (&task->cancelled);
+}
+
+
+/* INTERNAL POST
+------------------------------------------- */
+// Hands a reference to the task over to the message. The dispatcher keeps its
+// window as long as the thread runs, so a posted message is always delivered.
+// The last reference may release windows and bound data and is never dropped
+// on a worker: when the thread is gone the task is leaked.
+static void win32_task_post (Win32Task *task, WPARAM kind)
+{
+    PostMessage (task->dispatcher->hwnd, win32_task_message, kind, (LPARAM) task);
+}
+
+
+/* METHOD REPORT PROGRESS
+------------------------------------------- */
+// Called by the work function with a value between 0 and 1. Only the latest
+// value is delivered, at most once every TASK_PROGRESS_INTERVAL ms and never
+// while the previous one is still queued.
+void win32_task_report_progress (Win32Task *task, double progress)
+{
+    progress = CLAMP (progress, 0.0, 1.0);
+    g_atomic_int_set (&task->progressValue, (int) (progress * TASK_PROGRESS_SCALE));
+
+    guint64 now = GetTickCount64 ();
+    if ( now - task->lastProgress < TASK_PROGRESS_INTERVAL ) return;
+    if ( !g_atomic_int_compare_and_exchange (&task->progressPending, 0, 1) ) return;
+    task->lastProgress = now;
+
+    win32_task_ref (task);
+    win32_task_post (task, TASK_PROGRESS);
+}
+
+
+/* INTERNAL WORKER
+------------------------------------------- */
+static void win32_task_execute (gpointer data, gpointer userData)
+{
+    Win32Task *task = data;
+    if ( !win32_task_is_cancelled (task) ) task->work (task, task->workData);
+
+    // Posted after any progress, the window receives them in order
+    win32_task_post (task, TASK_DONE);
+}
+
+
+/* INTERNAL DELIVER
+------------------------------------------- */
+// Runs the callbacks of a task message, from the dispatcher
+void win32_task_deliver (WPARAM kind, LPARAM lParam)
+{
+    Win32Task *task = (Win32Task*) lParam;
+
+    if ( kind == TASK_PROGRESS ){
+        g_atomic_int_set (&task->progressPending, 0);
+        if ( task->progress != NULL && !win32_task_is_cancelled (task) ){
+            double progress = (double) g_atomic_int_get (&task->progressValue) / TASK_PROGRESS_SCALE;
+            task->progress (task, progress, task->progressData);
+        }
+    } else if ( task->done != NULL ){
+        task->done (task, task->doneData);
+    }
+
+    win32_task_unref (task);
+}
+
+
+/* INTERNAL REF TASK
+------------------------------------------- */
+void* win32_task_ref (void* instance)
+{
+    Win32Task * self = instance;
+    g_atomic_int_inc (&self->ref_count);
+    return self;
+}
+
+
+/* INTERNAL UNREF TASK
+------------------------------------------- */
+void win32_task_unref (void* instance)
+{
+    Win32Task * self = instance;
+    if (g_atomic_int_dec_and_test (&self->ref_count)) {
+        if ( self->releaseWorkData != NULL ) self->releaseWorkData (self->workData);
+        if ( self->releaseDoneData != NULL ) self->releaseDoneData (self->doneData);
+        if ( self->releaseProgressData != NULL ) self->releaseProgressData (self->progressData);
+        win32_window_unref (self->window);
+        free (self);
+    }
+}
@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_TASK_H
+#define WIN32_TASK_H
+
+#include <windows.h>
+#include <glib.h>
+
+#define TASK_PROGRESS_INTERVAL  50        // ms, progress is delivered at most this often
+#define TASK_PROGRESS_SCALE     1000000   // progress is kept in millionths
+
+#define TASK_DONE      0   // wParam of the task message
+#define TASK_PROGRESS  1
+
+typedef struct _Win32Task Win32Task;
+
+// Runs on a worker thread, the task is polled for cancellation
+typedef void (*Win32TaskFunction) (Win32Task *task, void *boundData);
+// Run on the thread that created the task
+typedef void (*Win32TaskCallback) (Win32Task *task, void *boundData);
+typedef void (*Win32ProgressCallback) (Win32Task *task, double progress, void *boundData);
+
+/* STRUCT Task (REF COUNTED)
+------------------------------------------- */
+// A piece of work run on the worker threads. Its completion and progress are
+// posted to the dispatcher of the thread that created it, which outlives the
+// window's handle, and delivered on that thread.
+// Tasks are shared between threads, they're always refcounted atomically.
+struct _Win32Task {
+    volatile int ref_count;
+    Win32Window *window;
+    Win32Dispatcher *dispatcher;    // of the thread that created the task, the messages go there
+
+    Win32TaskFunction work;
+    void *workData;
+    Win32ReleaseFunction releaseWorkData;
+    Win32TaskCallback done;
+    void *doneData;
+    Win32ReleaseFunction releaseDoneData;
+    Win32ProgressCallback progress;
+    void *progressData;
+    Win32ReleaseFunction releaseProgressData;
+
+    volatile int cancelled;
+    volatile int started;
+    volatile int progressValue;     // the latest progress reported, see TASK_PROGRESS_SCALE
+    volatile int progressPending;   // a progress message is on its way
+    guint64 lastProgress;           // tick count of the last progress message, worker side
+};
+
+extern UINT win32_task_message;     // registered with the first task, 0 before that
+
+Win32Task* win32_task_new (Win32Window *window, Win32TaskFunction work, void *boundData, Win32ReleaseFunction releaseData);
+void  win32_task_on_done     (Win32Task *task, Win32TaskCallback callback, void *boundData, Win32ReleaseFunction releaseData);
+void  win32_task_on_progress (Win32Task *task, Win32ProgressCallback callback, void *boundData, Win32ReleaseFunction releaseData);
+BOOL  win32_task_start  (Win32Task *task);
+void  win32_task_cancel (Win32Task *task);
+
+// For the work function
+BOOL  win32_task_is_cancelled    (Win32Task *task);
+void  win32_task_report_progress (Win32Task *task, double progress);
+
+void* win32_task_ref   (void*);
+void  win32_task_unref (void*);
+
+/* INTERNAL */
+void  win32_task_deliver (WPARAM kind, LPARAM lParam);
+
+#endif
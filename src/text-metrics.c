@@ -0,0 +1,187 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+static HDC   g_context = NULL;   // memory DC all the measurements are made on
+static HFONT g_selectedFont = NULL;
+static int   g_lineHeight = 0;   // of the selected font
+
+static Win32TextExtent g_entries[TEXT_METRICS_CACHE_SIZE];
+static int g_buckets[TEXT_METRICS_BUCKETS];     // index + 1 of the first entry, 0 when empty
+static int g_numEntries = 0;
+static int g_newest = -1;
+static int g_oldest = -1;
+
+#define BUCKET_OF(hash) ((size_t) ((hash) >> 32) & (TEXT_METRICS_BUCKETS - 1))
+
+
+/* INTERNAL HASH
+------------------------------------------- */
+// FNV-1a over the code units, mixed with the font handle
+static guint64 win32_text_metrics_hash (HFONT font, const wchar_t *text, size_t length)
+{
+    guint64 hash = 0xCBF29CE484222325ULL ^ (guint64) (guintptr) font;
+    for (size_t i=0; i<length; i++){
+        hash ^= (guint16) text[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+
+/* INTERNAL RECENCY LIST
+------------------------------------------- */
+static void win32_text_metrics_unlink (int index)
+{
+    Win32TextExtent *entry = &g_entries[index];
+    if ( entry->newer >= 0 ) g_entries[entry->newer].older = entry->older; else g_newest = entry->older;
+    if ( entry->older >= 0 ) g_entries[entry->older].newer = entry->newer; else g_oldest = entry->newer;
+}
+
+static void win32_text_metrics_push (int index)
+{
+    Win32TextExtent *entry = &g_entries[index];
+    entry->newer = -1;
+    entry->older = g_newest;
+    if ( g_newest >= 0 ) g_entries[g_newest].newer = index; else g_oldest = index;
+    g_newest = index;
+}
+
+
+/* INTERNAL EVICTION
+------------------------------------------- */
+// Takes the least recently used entry out of its bucket and returns its index
+static int win32_text_metrics_evict (void)
+{
+    int index = g_oldest;
+    Win32TextExtent *entry = &g_entries[index];
+    int *link = &g_buckets[ BUCKET_OF(entry->hash) ];
+
+    while ( *link != index + 1 ) link = &g_entries[*link - 1].next;
+    *link = entry->next;
+
+    win32_text_metrics_unlink (index);
+    free (entry->text);
+    entry->text = NULL;
+    return index;
+}
+
+
+/* INTERNAL MEASUREMENT
+------------------------------------------- */
+static BOOL win32_text_metrics_compute (HFONT font, const wchar_t *text, size_t length, SIZE *size)
+{
+    if ( g_context == NULL ){
+        g_context = CreateCompatibleDC (NULL);
+        if ( g_context == NULL ) return FALSE;
+    }
+    if ( font != g_selectedFont ){
+        TEXTMETRIC metrics;
+        SelectObject (g_context, font);
+        GetTextMetrics (g_context, &metrics);
+        g_selectedFont = font;
+        g_lineHeight = metrics.tmHeight;
+    }
+
+    size->cx = 0;
+    size->cy = 0;
+    size_t start = 0;
+    do {
+        size_t end = start;
+        while ( end < length && text[end] != L'\n' ) end++;
+        // the carriage return of a CRLF pair does not take up space
+        size_t lineLength = ( end > start && text[end-1] == L'\r' ) ? end - start - 1 : end - start;
+
+        SIZE line = { 0, g_lineHeight };
+        if ( lineLength > 0 ){
+            WIN32_COUNT_CALL (WIN32_CALL_GET_TEXT_EXTENT);
+            if ( !GetTextExtentPoint32 (g_context, text + start, lineLength, &line) ) return FALSE;
+        }
+        if ( line.cx > size->cx ) size->cx = line.cx;
+        size->cy += line.cy;
+        start = end + 1;
+    } while ( start <= length );
+
+    return TRUE;
+}
+
+
+/* METHOD MEASURE
+------------------------------------------- */
+// Returns the cached size when the same text was measured with the same font
+// recently.
+BOOL win32_text_metrics_measure (HFONT font, const wchar_t *text, size_t length, SIZE *size)
+{
+    if ( font == NULL ) font = (HFONT) GetStockObject (SYSTEM_FONT);
+
+    guint64 hash = win32_text_metrics_hash (font, text, length);
+    int *bucket = &g_buckets[ BUCKET_OF(hash) ];
+
+    for (int link = *bucket; link != 0; link = g_entries[link - 1].next){
+        int index = link - 1;
+        Win32TextExtent *entry = &g_entries[index];
+        if ( entry->hash != hash || entry->font != font || entry->length != length ) continue;
+        if ( memcmp (entry->text, text, length * sizeof(wchar_t)) != 0 ) continue;
+
+        WIN32_COUNT_CACHE (WIN32_CACHE_TEXT_EXTENT_HIT);
+        win32_text_metrics_unlink (index);
+        win32_text_metrics_push (index);
+        *size = entry->size;
+        return TRUE;
+    }
+
+    WIN32_COUNT_CACHE (WIN32_CACHE_TEXT_EXTENT_MISS);
+    if ( !win32_text_metrics_compute (font, text, length, size) ) return FALSE;
+
+    wchar_t *copy = malloc ( (length + 1) * sizeof(wchar_t) );
+    if ( copy == NULL ) return TRUE; // measured, just not cached
+    memcpy (copy, text, length * sizeof(wchar_t));
+    copy[length] = 0;
+
+    int index = ( g_numEntries < TEXT_METRICS_CACHE_SIZE ) ? g_numEntries++ : win32_text_metrics_evict ();
+    Win32TextExtent *entry = &g_entries[index];
+    entry->font   = font;
+    entry->hash   = hash;
+    entry->length = length;
+    entry->text   = copy;
+    entry->size   = *size;
+    entry->next   = *bucket;
+    *bucket = index + 1;
+    win32_text_metrics_push (index);
+
+    return TRUE;
+}
+
+
+/* METHOD MEASURE WINDOW
+------------------------------------------- */
+// Measures the text in the font of the window, an empty text has the height
+// of a line. Meant for the auto_resize virtual method of controls.
+BOOL win32_text_metrics_measure_window (Win32Window *window, const wchar_t *text, SIZE *size)
+{
+    HFONT font = (HFONT) SendMessage (window->hwnd, WM_GETFONT, 0, 0);
+    return win32_text_metrics_measure (font, text, ( text != NULL ) ? wcslen (text) : 0, size);
+}
+
+
+/* METHOD CLEAR
+------------------------------------------- */
+// Releases the cached sizes and the memory DC. Has to be called before a font
+// that has been measured is deleted, the DC keeps it selected.
+void win32_text_metrics_clear (void)
+{
+    for (int i=0; i<g_numEntries; i++){
+        free (g_entries[i].text);
+        g_entries[i].text = NULL;
+    }
+    memset (g_buckets, 0, sizeof(g_buckets));
+    g_numEntries = 0;
+    g_newest = g_oldest = -1;
+
+    if ( g_context != NULL ) DeleteDC (g_context);
+    g_context = NULL;
+    g_selectedFont = NULL;
+}
@@ -0,0 +1,38 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32_TEXT_METRICS_H
+#define WIN32_TEXT_METRICS_H
+
+#include <windows.h>
+#include <glib-object.h>
+#include <glib.h>
+
+#define TEXT_METRICS_CACHE_SIZE    64   // measured strings kept, the least recently used is evicted first
+#define TEXT_METRICS_BUCKETS      128   // power of two, at least TEXT_METRICS_CACHE_SIZE
+
+/* STRUCT TextExtent
+------------------------------------------- */
+typedef struct _Win32TextExtent {
+    HFONT    font;
+    guint64  hash;
+    size_t   length;
+    wchar_t *text;
+    SIZE     size;
+    int      next;      // index + 1 of the next entry in the same bucket, 0 at the end
+    int      newer;     // neighbours in the recency list
+    int      older;
+} Win32TextExtent;
+
+/* SERVICE TextMetrics
+------------------------------------------- */
+// Measures text on a memory DC owned by the service instead of a window DC.
+// Lines are separated by '\n', the widest line gives the width. The service
+// belongs to the UI thread.
+BOOL win32_text_metrics_measure        (HFONT font, const wchar_t *text, size_t length, SIZE *size);
+BOOL win32_text_metrics_measure_window (Win32Window *window, const wchar_t *text, SIZE *size);
+void win32_text_metrics_clear          (void);
+
+#endif
@@ -0,0 +1,387 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "vala-win32.h"
+
+static const wchar_t *szClassName = L"Win32TreeView";
+static WNDPROC g_baseProc = NULL;  // procedure of the system class, see the superclass
+static gpointer win32_tree_view_parent_class = NULL;
+
+static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+static GType win32_tree_view_get_type_once (void);
+static void win32_tree_view_finalize (Win32Window * obj);
+
+HWND win32_tree_view_create (Win32Window *self, Win32Window *parent);
+
+/* CONSTRUCTOR
+------------------------------------------- */
+Win32TreeView* win32_tree_view_construct (GType object_type, Win32Window* parent)
+{
+    Win32TreeView* self = NULL;
+    self = (Win32TreeView*) win32_control_construct (object_type, parent, win32_tree_view_create, NULL);
+    return self;
+}
+
+Win32TreeView* win32_tree_view_new (Win32Window* parent)
+{
+    return win32_tree_view_construct (WIN32_TYPE_TREE_VIEW, parent);
+}
+
+
+/* INTERNAL LOAD CHILDREN
+------------------------------------------- */
+static void win32_tree_view_load_children (Win32TreeView *self, HTREEITEM parent)
+{
+    if ( self->provider != NULL ) self->provider (self, parent, self->providerData);
+}
+
+
+/* INTERNAL CREATE
+------------------------------------------- */
+// The roots are loaded along with the control, a recreated control starts
+// collapsed
+HWND win32_tree_view_create (Win32Window *self, Win32Window *parent)
+{
+    HWND hwnd;
+    Win32Window  *window  = (Win32Window*) self;
+    Win32Control *control = (Win32Control*) self;
+
+    // default size
+    window->width  = (window->pref_width > 0) ? window->pref_width : 200;
+    window->height = (window->pref_height > 0) ? window->pref_height : 150;
+
+    control->id = win32_control_generate_ID ();
+
+    // Creating the Window
+    hwnd = CreateWindowEx(
+        WS_EX_CLIENTEDGE,
+        szClassName,
+        L"",
+        // Control Styles:
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | TVS_HASBUTTONS | TVS_HASLINES | TVS_LINESATROOT | TVS_SHOWSELALWAYS,
+        window->left,   // x position
+        window->top,    // y position
+        window->width,  // width
+        window->height, // height
+        parent->hwnd,   // Parent window
+        (HANDLE) control->id, // Control ID
+        window->hInstance,
+        window );
+
+    // window->hwnd is assigned on WM_NCCREATE
+    if ( hwnd == NULL ) return NULL;
+
+    win32_tree_view_load_children ((Win32TreeView*) self, NULL);
+
+    return hwnd;
+}
+
+
+/* METHOD SET CHILDREN PROVIDER
+------------------------------------------- */
+void win32_tree_view_set_children_provider (Win32TreeView *instance,
+                                            Win32TreeChildrenProvider provider,
+                                            void *boundData,
+                                            Win32ReleaseFunction releaseData)
+{
+    if ( instance->releaseProviderData != NULL ) instance->releaseProviderData (instance->providerData);
+
+    instance->provider = provider;
+    instance->providerData = boundData;
+    instance->releaseProviderData = releaseData;
+
+    win32_tree_view_reload (instance);
+}
+
+
+/* METHOD SET CHILDREN QUERY
+------------------------------------------- */
+// Without a query every item shows an expand button until it is expanded
+void win32_tree_view_set_children_query (Win32TreeView *instance,
+                                         Win32TreeChildrenQuery query,
+                                         void *boundData,
+                                         Win32ReleaseFunction releaseData)
+{
+    if ( instance->releaseQueryData != NULL ) instance->releaseQueryData (instance->queryData);
+
+    instance->query = query;
+    instance->queryData = boundData;
+    instance->releaseQueryData = releaseData;
+}
+
+
+/* PROPERTY SET RELEASE COLLAPSED
+------------------------------------------- */
+void win32_tree_view_set_release_collapsed (Win32TreeView *instance, BOOL value)
+{
+    instance->releaseCollapsed = value;
+}
+
+
+/* PROPERTY GET RELEASE COLLAPSED
+------------------------------------------- */
+BOOL win32_tree_view_get_release_collapsed (Win32TreeView *instance)
+{
+    return instance->releaseCollapsed;
+}
+
+
+/* METHOD INSERT
+------------------------------------------- */
+// Appends an item under parent, a root when parent is NULL. Meant to be called
+// from the children provider. Whether the item has children is asked later.
+HTREEITEM win32_tree_view_insert (Win32TreeView *instance, HTREEITEM parent, const char *text, gintptr key)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL ) return NULL;
+
+    Win32WideString wideText;
+    win32_wide_string_init( &wideText, ( text != NULL ) ? text : "" );
+
+    TVINSERTSTRUCT insert;
+    memset( &insert, 0, sizeof(TVINSERTSTRUCT) );
+    insert.hParent         = ( parent != NULL ) ? parent : TVI_ROOT;
+    insert.hInsertAfter    = TVI_LAST;
+    insert.item.mask       = TVIF_TEXT | TVIF_PARAM | TVIF_CHILDREN;
+    insert.item.pszText    = wideText.str;
+    insert.item.lParam     = (LPARAM) key;
+    insert.item.cChildren  = I_CHILDRENCALLBACK;
+
+    HTREEITEM item = (HTREEITEM) SendMessage( window->hwnd, TVM_INSERTITEM, 0, (LPARAM) &insert );
+
+    win32_wide_string_release( &wideText );
+    return item;
+}
+
+
+/* METHOD GET KEY
+------------------------------------------- */
+gintptr win32_tree_view_get_key (Win32TreeView *instance, HTREEITEM item)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL || item == NULL ) return 0;
+
+    TVITEM data;
+    data.mask  = TVIF_HANDLE | TVIF_PARAM;
+    data.hItem = item;
+    if ( !SendMessage( window->hwnd, TVM_GETITEM, 0, (LPARAM) &data ) ) return 0;
+    return (gintptr) data.lParam;
+}
+
+
+/* METHOD GET PARENT
+------------------------------------------- */
+// NULL for the roots
+HTREEITEM win32_tree_view_get_parent (Win32TreeView *instance, HTREEITEM item)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL || item == NULL ) return NULL;
+
+    return (HTREEITEM) SendMessage( window->hwnd, TVM_GETNEXTITEM, TVGN_PARENT, (LPARAM) item );
+}
+
+
+/* METHOD GET ITEM TEXT
+------------------------------------------- */
+// Returns a copy of the text of the item, freed with g_free
+char* win32_tree_view_get_item_text (Win32TreeView *instance, HTREEITEM item)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL || item == NULL ) return NULL;
+
+    wchar_t buffer[TREE_ITEM_TEXT_SIZE];
+    TVITEM data;
+    data.mask       = TVIF_HANDLE | TVIF_TEXT;
+    data.hItem      = item;
+    data.pszText    = buffer;
+    data.cchTextMax = TREE_ITEM_TEXT_SIZE;
+    if ( !SendMessage( window->hwnd, TVM_GETITEM, 0, (LPARAM) &data ) ) return NULL;
+
+    size_t length = wcslen (data.pszText);
+    char *text = g_malloc( UTF8_MAX_LENGTH(length) + 1 );
+    text[ win32_utf16_to_utf8 ((uint16_t*) data.pszText, length, text) ] = 0;
+    return text;
+}
+
+
+/* METHOD GET ITEM COUNT
+------------------------------------------- */
+// Items currently loaded into the control
+guint win32_tree_view_get_item_count (Win32TreeView *instance)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL ) return 0;
+
+    return (guint) SendMessage( window->hwnd, TVM_GETCOUNT, 0, 0 );
+}
+
+
+/* METHOD EXPAND
+------------------------------------------- */
+void win32_tree_view_expand (Win32TreeView *instance, HTREEITEM item)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL || item == NULL ) return;
+
+    SendMessage( window->hwnd, TVM_EXPAND, TVE_EXPAND, (LPARAM) item );
+}
+
+
+/* METHOD COLLAPSE
+------------------------------------------- */
+// The control only notifies the first collapse of a branch, the items are
+// released here as they would be when the user collapses it
+void win32_tree_view_collapse (Win32TreeView *instance, HTREEITEM item)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL || item == NULL ) return;
+
+    UINT action = instance->releaseCollapsed ? TVE_COLLAPSE | TVE_COLLAPSERESET : TVE_COLLAPSE;
+    instance->releasing = TRUE;
+    SendMessage( window->hwnd, TVM_EXPAND, action, (LPARAM) item );
+    instance->releasing = FALSE;
+}
+
+
+/* METHOD RELOAD
+------------------------------------------- */
+// Deletes every item and loads the roots again
+void win32_tree_view_reload (Win32TreeView *instance)
+{
+    Win32Window *window = (Win32Window*) instance;
+    if ( window->hwnd == NULL ) return;
+
+    SendMessage( window->hwnd, TVM_DELETEITEM, 0, (LPARAM) TVI_ROOT );
+    win32_tree_view_load_children (instance, NULL);
+}
+
+
+/* INTERNAL NOTIFICATIONS
+------------------------------------------- */
+// Notifications are forwarded by the parent window as FM_NOTIFY
+static LRESULT win32_tree_view_notify (Win32TreeView *self, NMHDR *header)
+{
+    HWND hwnd = ((Win32Window*) self)->hwnd;
+
+    switch (header->code){
+        case TVN_GETDISPINFO: {
+            TVITEM *item = &((NMTVDISPINFO*) header)->item;
+            if ( item->mask & TVIF_CHILDREN ){
+                item->cChildren = ( self->query == NULL ) || self->query (self, item->hItem, self->queryData);
+            }
+            return 0; }
+
+        case TVN_ITEMEXPANDING: {
+            NMTREEVIEW *tree = (NMTREEVIEW*) header;
+            if ( !(tree->action & TVE_EXPAND) ) return FALSE;
+            // Load the children unless they're loaded already
+            if ( SendMessage( hwnd, TVM_GETNEXTITEM, TVGN_CHILD, (LPARAM) tree->itemNew.hItem ) == 0 ){
+                win32_tree_view_load_children (self, tree->itemNew.hItem);
+            }
+            return FALSE; }
+
+        case TVN_ITEMEXPANDED: {
+            NMTREEVIEW *tree = (NMTREEVIEW*) header;
+            if ( !self->releaseCollapsed || self->releasing || !(tree->action & TVE_COLLAPSE) ) return 0;
+            // Deletes the children and forgets the branch was expanded
+            self->releasing = TRUE;
+            SendMessage( hwnd, TVM_EXPAND, TVE_COLLAPSE | TVE_COLLAPSERESET, (LPARAM) tree->itemNew.hItem );
+            self->releasing = FALSE;
+            return 0; }
+    }
+    return 0;
+}
+
+
+/* INTERNAL WINDOW PROCEDURE
+------------------------------------------- */
+// the Window Procedure
+LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    WIN32_PROFILE_BEGIN (start);
+    LRESULT result;
+    result = win32_window_default_procedure(hwnd, msg, wParam, lParam);
+    if ( result == STOP_PROPAGATION ) return WIN32_PROFILE_MESSAGE (msg, start, 0);
+
+    if ( msg == FM_NOTIFY ){
+        Win32TreeView *self = (Win32TreeView*) GetWindowLongPtr( hwnd, GWLP_USERDATA );
+        return WIN32_PROFILE_MESSAGE (msg, start, ( self != NULL ) ? win32_tree_view_notify (self, (NMHDR*) lParam) : 0);
+    }
+
+    return WIN32_PROFILE_MESSAGE (msg, start, CallWindowProc( g_baseProc, hwnd, msg, wParam, lParam));
+}
+
+
+/* INTERNAL GTYPE
+------------------------------------------- */
+static void win32_tree_view_class_init (Win32TreeViewClass * klass, gpointer klass_data)
+{
+    win32_tree_view_parent_class = g_type_class_peek_parent (klass);
+    ((Win32WindowClass *) klass)->finalize = win32_tree_view_finalize;
+
+    // The system class is registered by the common controls library
+    INITCOMMONCONTROLSEX controls = { sizeof(INITCOMMONCONTROLSEX), ICC_TREEVIEW_CLASSES };
+    InitCommonControlsEx (&controls);
+
+    // Register the superclass once, every tree view shares it
+    g_baseProc = win32_control_register_superclass( WC_TREEVIEW, szClassName, WndProc );
+    if ( g_baseProc == NULL ){
+        MessageBox(NULL, L"Window Registration Failed!", L"Error!", MB_ICONEXCLAMATION | MB_OK);
+        exit (1); // exit
+    }
+}
+
+static void win32_tree_view_instance_init (Win32TreeView * self, gpointer klass)
+{
+}
+
+/* INTERNAL CLEANUP
+------------------------------------------- */
+static void win32_tree_view_finalize (Win32Window * obj)
+{
+    Win32TreeView * self;
+    self = G_TYPE_CHECK_INSTANCE_CAST (obj, WIN32_TYPE_TREE_VIEW, Win32TreeView);
+
+    // The control may still notify while it is destroyed, there's nothing to provide by then
+    if ( self->releaseProviderData != NULL ) self->releaseProviderData (self->providerData);
+    if ( self->releaseQueryData != NULL ) self->releaseQueryData (self->queryData);
+    self->provider = NULL;
+    self->query    = NULL;
+
+    WIN32_WINDOW_CLASS (win32_tree_view_parent_class)->finalize (obj);
+}
+
+
+/* INTERNAL GTYPE REGISTRATION
+------------------------------------------- */
+static GType win32_tree_view_get_type_once (void)
+{
+    static const GTypeInfo g_define_type_info = {
+        sizeof (Win32TreeViewClass),
+        (GBaseInitFunc) NULL,
+        (GBaseFinalizeFunc) NULL,
+        (GClassInitFunc) win32_tree_view_class_init,
+        (GClassFinalizeFunc) NULL,
+        NULL,
+        sizeof (Win32TreeView),
+        0,
+        (GInstanceInitFunc) win32_tree_view_instance_init,
+        NULL
+    };
+    GType win32_tree_view_type_id;
+    win32_tree_view_type_id = g_type_register_static (WIN32_TYPE_CONTROL, "Win32TreeView", &g_define_type_info, 0);
+    return win32_tree_view_type_id;
+}
+
+GType win32_tree_view_get_type (void)
+{
+    static volatile gsize win32_tree_view_type_id__volatile = 0;
+    if (g_once_init_enter (&win32_tree_view_type_id__volatile)) {
+        GType win32_tree_view_type_id;
+        win32_tree_view_type_id = win32_tree_view_get_type_once ();
+        g_once_init_leave (&win32_tree_view_type_id__volatile, win32_tree_view_type_id);
+    }
+    return win32_tree_view_type_id__volatile;
+}
@@ -0,0 +1,84 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef _WIN32_TREE_VIEW_H_
+#define _WIN32_TREE_VIEW_H_
+
+#include <windows.h>
+#include <commctrl.h>
+#include <glib-object.h>
+#include "window.h"
+#include "control.h"
+
+#define TREE_ITEM_TEXT_SIZE  1024  // longest item text returned, the control shows less anyway
+
+typedef struct _Win32TreeView Win32TreeView;
+typedef struct _Win32TreeViewClass Win32TreeViewClass;
+
+// Inserts the children of the item with win32_tree_view_insert, the item is
+// NULL for the roots
+typedef void     (*Win32TreeChildrenProvider) (Win32TreeView *tree, HTREEITEM parent, void *boundData);
+// Whether the item has children to show an expand button for, asked when the
+// item is painted
+typedef gboolean (*Win32TreeChildrenQuery) (Win32TreeView *tree, HTREEITEM item, void *boundData);
+
+#define WIN32_TYPE_TREE_VIEW (win32_tree_view_get_type ())
+#define WIN32_TREE_VIEW(obj) (G_TYPE_CHECK_INSTANCE_CAST ((obj), WIN32_TYPE_TREE_VIEW, Win32TreeView))
+#define WIN32_TREE_VIEW_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST ((klass), WIN32_TYPE_TREE_VIEW, Win32TreeViewClass))
+#define WIN32_IS_TREE_VIEW(obj) (G_TYPE_CHECK_INSTANCE_TYPE ((obj), WIN32_TYPE_TREE_VIEW))
+#define WIN32_IS_TREE_VIEW_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass), WIN32_TYPE_TREE_VIEW))
+#define WIN32_TREE_VIEW_GET_CLASS(obj) (G_TYPE_INSTANCE_GET_CLASS ((obj), WIN32_TYPE_TREE_VIEW, Win32TreeViewClass))
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (Win32TreeView, win32_window_unref)
+
+/* CLASS TreeView
+------------------------------------------- */
+// Items are loaded when their parent is expanded for the first time. Every
+// item carries an integer key of the application to find its data with.
+struct _Win32TreeView {
+    Win32Control parent_instance;
+    BOOL releaseCollapsed;  // collapsing a branch deletes its items, they're loaded again on expand
+    BOOL releasing;         // a branch is being deleted, its collapse isn't handled again
+
+    Win32TreeChildrenProvider provider;
+    void *providerData;
+    Win32ReleaseFunction releaseProviderData;
+    Win32TreeChildrenQuery query;
+    void *queryData;
+    Win32ReleaseFunction releaseQueryData;
+};
+
+struct _Win32TreeViewClass {
+    Win32ControlClass parent_class;
+};
+
+Win32TreeView* win32_tree_view_new (Win32Window* parent);
+
+void win32_tree_view_set_children_provider (Win32TreeView *instance,
+                                            Win32TreeChildrenProvider provider,
+                                            void *boundData,
+                                            Win32ReleaseFunction releaseData);
+void win32_tree_view_set_children_query (Win32TreeView *instance,
+                                         Win32TreeChildrenQuery query,
+                                         void *boundData,
+                                         Win32ReleaseFunction releaseData);
+
+void win32_tree_view_set_release_collapsed (Win32TreeView *instance, BOOL value);
+BOOL win32_tree_view_get_release_collapsed (Win32TreeView *instance);
+
+HTREEITEM win32_tree_view_insert (Win32TreeView *instance, HTREEITEM parent, const char *text, gintptr key);
+gintptr   win32_tree_view_get_key (Win32TreeView *instance, HTREEITEM item);
+HTREEITEM win32_tree_view_get_parent (Win32TreeView *instance, HTREEITEM item);
+char*     win32_tree_view_get_item_text (Win32TreeView *instance, HTREEITEM item);
+guint     win32_tree_view_get_item_count (Win32TreeView *instance);
+void      win32_tree_view_expand (Win32TreeView *instance, HTREEITEM item);
+void      win32_tree_view_collapse (Win32TreeView *instance, HTREEITEM item);
+void      win32_tree_view_reload (Win32TreeView *instance);
+
+/* INTERNAL */
+GType win32_tree_view_get_type (void) G_GNUC_CONST;
+Win32TreeView* win32_tree_view_construct (GType object_type, Win32Window* parent);
+
+#endif
@@ -0,0 +1,203 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#include "unicode.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/* UTILITY ASCII WIDEN
+------------------------------------------- */
+// Copies the leading ASCII run of the source, stops at the first byte above
+// 0x7F. Returns the number of bytes copied.
+size_t win32_ascii_widen (const char *src, size_t length, uint16_t *dst)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for ( ; i + 32 <= length; i += 32 ){
+        __m256i chunk = _mm256_loadu_si256 ((const __m256i*) (src + i));
+        if ( _mm256_movemask_epi8 (chunk) != 0 ) break;
+        _mm256_storeu_si256 ((__m256i*) (dst + i),      _mm256_cvtepu8_epi16 (_mm256_castsi256_si128 (chunk)));
+        _mm256_storeu_si256 ((__m256i*) (dst + i + 16), _mm256_cvtepu8_epi16 (_mm256_extracti128_si256 (chunk, 1)));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128 ();
+    for ( ; i + 16 <= length; i += 16 ){
+        __m128i chunk = _mm_loadu_si128 ((const __m128i*) (src + i));
+        if ( _mm_movemask_epi8 (chunk) != 0 ) break;
+        _mm_storeu_si128 ((__m128i*) (dst + i),     _mm_unpacklo_epi8 (chunk, zero));
+        _mm_storeu_si128 ((__m128i*) (dst + i + 8), _mm_unpackhi_epi8 (chunk, zero));
+    }
+#endif
+    for ( ; i < length; i++ ){
+        unsigned char c = (unsigned char) src[i];
+        if ( c >= 0x80 ) break;
+        dst[i] = c;
+    }
+    return i;
+}
+
+
+/* UTILITY ASCII NARROW
+------------------------------------------- */
+// Copies the leading run of units below 0x80, stops at the first other unit.
+// Returns the number of units copied.
+size_t win32_ascii_narrow (const uint16_t *src, size_t length, char *dst)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i nonAscii256 = _mm256_set1_epi16 ((short) 0xFF80);
+    for ( ; i + 32 <= length; i += 32 ){
+        __m256i low  = _mm256_loadu_si256 ((const __m256i*) (src + i));
+        __m256i high = _mm256_loadu_si256 ((const __m256i*) (src + i + 16));
+        if ( !_mm256_testz_si256 (_mm256_or_si256 (low, high), nonAscii256) ) break;
+        // packing works within the 128-bit lanes, the permutation restores the order
+        __m256i packed = _mm256_permute4x64_epi64 (_mm256_packus_epi16 (low, high), 0xD8);
+        _mm256_storeu_si256 ((__m256i*) (dst + i), packed);
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i nonAscii = _mm_set1_epi16 ((short) 0xFF80);
+    const __m128i zero = _mm_setzero_si128 ();
+    for ( ; i + 16 <= length; i += 16 ){
+        __m128i low  = _mm_loadu_si128 ((const __m128i*) (src + i));
+        __m128i high = _mm_loadu_si128 ((const __m128i*) (src + i + 8));
+        __m128i test = _mm_and_si128 (_mm_or_si128 (low, high), nonAscii);
+        if ( _mm_movemask_epi8 (_mm_cmpeq_epi16 (test, zero)) != 0xFFFF ) break;
+        _mm_storeu_si128 ((__m128i*) (dst + i), _mm_packus_epi16 (low, high));
+    }
+#endif
+    for ( ; i < length; i++ ){
+        if ( src[i] >= 0x80 ) break;
+        dst[i] = (char) src[i];
+    }
+    return i;
+}
+
+
+/* INTERNAL DECODE
+------------------------------------------- */
+// Decodes the multi-byte sequence at the start of the source. An ill-formed
+// sequence is replaced by U+FFFD, consuming its maximal subpart as the Unicode
+// standard recommends. Returns the number of bytes consumed.
+static size_t decode_sequence (const unsigned char *src, size_t length, uint32_t *codePoint)
+{
+    unsigned char c = src[0];
+    unsigned char lower = 0x80, upper = 0xBF;
+    size_t needed;
+    uint32_t value;
+
+    if ( c >= 0xC2 && c <= 0xDF ){
+        needed = 1; value = c & 0x1F;
+    } else if ( c >= 0xE0 && c <= 0xEF ){
+        needed = 2; value = c & 0x0F;
+        if ( c == 0xE0 ) lower = 0xA0;      // overlong
+        if ( c == 0xED ) upper = 0x9F;      // surrogates
+    } else if ( c >= 0xF0 && c <= 0xF4 ){
+        needed = 3; value = c & 0x07;
+        if ( c == 0xF0 ) lower = 0x90;      // overlong
+        if ( c == 0xF4 ) upper = 0x8F;      // above U+10FFFF
+    } else {
+        *codePoint = UNICODE_REPLACEMENT_CHARACTER;
+        return 1;
+    }
+
+    size_t i = 1;
+    for ( ; i <= needed; i++ ){
+        if ( i >= length || src[i] < lower || src[i] > upper ){
+            *codePoint = UNICODE_REPLACEMENT_CHARACTER;
+            return i;
+        }
+        value = (value << 6) | (src[i] & 0x3F);
+        lower = 0x80; upper = 0xBF;
+    }
+    *codePoint = value;
+    return i;
+}
+
+
+/* UTILITY UTF-8 TO UTF-16
+------------------------------------------- */
+// Converts `length` bytes, the destination must hold UTF16_MAX_LENGTH(length)
+// units. No terminator is written. Returns the number of units written.
+size_t win32_utf8_to_utf16 (const char *src, size_t length, uint16_t *dst)
+{
+    const unsigned char *bytes = (const unsigned char *) src;
+    size_t i = 0, j = 0;
+    uint32_t codePoint;
+
+    while ( i < length ){
+        size_t ascii = win32_ascii_widen (src + i, length - i, dst + j);
+        i += ascii;
+        j += ascii;
+        if ( i == length ) break;
+
+        i += decode_sequence (bytes + i, length - i, &codePoint);
+        if ( codePoint >= 0x10000 ){
+            codePoint -= 0x10000;
+            dst[j++] = (uint16_t) (0xD800 | (codePoint >> 10));
+            dst[j++] = (uint16_t) (0xDC00 | (codePoint & 0x3FF));
+        } else {
+            dst[j++] = (uint16_t) codePoint;
+        }
+    }
+    return j;
+}
+
+
+/* UTILITY UTF-16 TO UTF-8
+------------------------------------------- */
+// Converts `length` units, the destination must hold UTF8_MAX_LENGTH(length)
+// bytes. Unpaired surrogates become U+FFFD. No terminator is written. Returns
+// the number of bytes written.
+size_t win32_utf16_to_utf8 (const uint16_t *src, size_t length, char *dst)
+{
+    unsigned char *bytes = (unsigned char *) dst;
+    size_t i = 0, j = 0;
+    uint32_t codePoint;
+
+    while ( i < length ){
+        size_t ascii = win32_ascii_narrow (src + i, length - i, dst + j);
+        i += ascii;
+        j += ascii;
+        if ( i == length ) break;
+
+        codePoint = src[i++];
+        if ( codePoint < 0x800 ){
+            bytes[j++] = (unsigned char) (0xC0 | (codePoint >> 6));
+            bytes[j++] = (unsigned char) (0x80 | (codePoint & 0x3F));
+            continue;
+        }
+        if ( codePoint >= 0xD800 && codePoint <= 0xDFFF ){
+            if ( codePoint <= 0xDBFF && i < length && src[i] >= 0xDC00 && src[i] <= 0xDFFF ){
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (src[i++] - 0xDC00);
+                bytes[j++] = (unsigned char) (0xF0 | (codePoint >> 18));
+                bytes[j++] = (unsigned char) (0x80 | ((codePoint >> 12) & 0x3F));
+                bytes[j++] = (unsigned char) (0x80 | ((codePoint >> 6) & 0x3F));
+                bytes[j++] = (unsigned char) (0x80 | (codePoint & 0x3F));
+                continue;
+            }
+            codePoint = UNICODE_REPLACEMENT_CHARACTER;
+        }
+        bytes[j++] = (unsigned char) (0xE0 | (codePoint >> 12));
+        bytes[j++] = (unsigned char) (0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[j++] = (unsigned char) (0x80 | (codePoint & 0x3F));
+    }
+    return j;
+}
+
+
+/* UTILITY
+------------------------------------------- */
+size_t win32_utf16_length (const uint16_t *src)
+{
+    size_t length = 0;
+    while ( src[length] != 0 ) length++;
+    return length;
+}
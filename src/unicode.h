@@ -0,0 +1,29 @@
+/*---------------------------------------------------------------------------------------------
+ *  Copyright (c) 2022 Emre ÖZÇAKIR  
+ *  Licensed under the MIT License. See License file in the project root for more information.
+ *-------------------------------------------------------------------------------------------*/
+
+#ifndef _WIN32_UNICODE_H_
+#define _WIN32_UNICODE_H_
+
+// Like the layout solver, the conversions are plain C working on 16-bit code
+// units rather than wchar_t, so they can be built and tested on any host.
+#include <stddef.h>
+#include <stdint.h>
+
+#define UNICODE_REPLACEMENT_CHARACTER 0xFFFD
+
+// Upper bounds of the converted length, the terminator excluded. A UTF-8 byte
+// never yields more than one UTF-16 unit and a UTF-16 unit never more than
+// three UTF-8 bytes, so the destination can be sized in advance.
+#define UTF16_MAX_LENGTH(utf8Length)  (utf8Length)
+#define UTF8_MAX_LENGTH(utf16Length)  ((utf16Length) * 3)
+
+size_t win32_utf8_to_utf16 (const char *src, size_t length, uint16_t *dst);
+size_t win32_utf16_to_utf8 (const uint16_t *src, size_t length, char *dst);
+size_t win32_utf16_length  (const uint16_t *src);
+
+size_t win32_ascii_widen  (const char *src, size_t length, uint16_t *dst);
+size_t win32_ascii_narrow (const uint16_t *src, size_t length, char *dst);
+
+#endif
@@ -22,17 +22,46 @@ HFONT win32_get_default_gui_font(void)
 }
 
 
+/* UTILITY WIDE STRING
+------------------------------------------- */
+// Converts the string into the inline buffer when it fits, otherwise into a
+// heap block released by win32_wide_string_release. Returns NULL for NULL.
+const wchar_t* win32_wide_string_init (Win32WideString *string, const char *src)
+{
+    string->str = NULL;
+    string->length = 0;
+    if ( !src ) return NULL;
+
+    size_t length = strlen (src);
+    string->str = string->buffer;
+    if ( UTF16_MAX_LENGTH(length) >= WIDE_STRING_BUFFER_SIZE ){
+        string->str = malloc( (UTF16_MAX_LENGTH(length) + 1) * sizeof(wchar_t) );
+        if ( !string->str ) return NULL;
+    }
+    string->length = win32_utf8_to_utf16 (src, length, (uint16_t*) string->str);
+    string->str[string->length] = 0;
+
+    return string->str;
+}
+
+void win32_wide_string_release (Win32WideString *string)
+{
+    if ( string->str != string->buffer ) free (string->str);
+    string->str = NULL;
+}
+
+
 /* UTILITY
 ------------------------------------------- */
 wchar_t* fromUTF8 (const char* src)
 {
     if(!src) return NULL;
 
-    int des_len = MultiByteToWideChar(CP_UTF8, 0, src, -1, 0, 0);
-    wchar_t *buffer = malloc( (des_len) * sizeof(wchar_t) );
+    size_t length = strlen (src);
+    wchar_t *buffer = malloc( (UTF16_MAX_LENGTH(length) + 1) * sizeof(wchar_t) );
 
     if (buffer) {
-        MultiByteToWideChar(CP_UTF8, 0, src, -1, buffer, des_len);
+        buffer[ win32_utf8_to_utf16 (src, length, (uint16_t*) buffer) ] = 0;
     }
 
     return buffer;
@@ -44,11 +73,17 @@ char* toUTF8(const wchar_t* src)
 {
     if(!src) return NULL;
 
-    int des_len = WideCharToMultiByte(CP_UTF8, 0, src, -1, 0, 0, NULL, NULL);
-    char *buffer = malloc( (des_len) * sizeof(char) );
+    size_t length = wcslen (src);
+    char *buffer = malloc( UTF8_MAX_LENGTH(length) + 1 );
 
     if (buffer) {
-        WideCharToMultiByte(CP_UTF8, 0, src, -1, buffer, des_len, NULL, NULL);
+        size_t written = win32_utf16_to_utf8 ((const uint16_t*) src, length, buffer);
+        buffer[written] = 0;
+        // the estimate is three times the length, give the unused part back
+        if ( written < UTF8_MAX_LENGTH(length) ){
+            char *shrunk = realloc (buffer, written + 1);
+            if (shrunk) buffer = shrunk;
+        }
     }
 
     return buffer;
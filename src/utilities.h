@@ -9,6 +9,21 @@
 #include <windows.h>
 #include <glib-object.h>
 #include <glib.h>
+#include "unicode.h"
+
+#define WIDE_STRING_BUFFER_SIZE 128  // units, most UI strings fit without a heap allocation
+
+/* STRUCT WideString
+------------------------------------------- */
+// Scratch space for a temporary UTF-16 copy of a string, usually on the stack
+typedef struct _Win32WideString {
+    wchar_t *str;
+    size_t   length;
+    wchar_t  buffer[WIDE_STRING_BUFFER_SIZE];
+} Win32WideString;
+
+const wchar_t* win32_wide_string_init    (Win32WideString *string, const char *src);
+void           win32_wide_string_release (Win32WideString *string);
 
 wchar_t* fromUTF8 (const char* src);
 char*    toUTF8   (const wchar_t* src);
@@ -12,32 +12,50 @@
 #define WINVER 0x0601 // Windows 7
 
 #include <windows.h>
+#include <commctrl.h>
 #include <glib-object.h>
 #include <glib.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-#define INITIAL_LIST_SIZE 16  // Initial size and also the growing size of the event list
+#define INITIAL_LIST_SIZE 16  // Initial capacity of the event list, doubled whenever it fills up
 #define INITIAL_QUEUE_SIZE 2  // the same for the callback list
 
 #define  FM_COMMAND    0x4000      // FM: Forwarded Message
 #define  FM_CLICKED    FM_COMMAND
+#define  FM_COALESCED  0x4001      // posted to deliver the coalesced events
+#define  FM_NOTIFY     0x4002      // WM_NOTIFY forwarded to the control that sent it
+#define  FM_INVOKE     0x4003      // posted once to the dispatcher to run the invocations queued by other threads
+
+#define  COALESCE_TIMER_ID   FM_COALESCED
+#define  COALESCE_INTERVAL   16    // ms, coalesced events are delivered about once a frame during live resize
 
 typedef struct _Win32Window Win32Window;
 typedef struct _Win32Container Win32Container;
+typedef struct _Win32Dispatcher Win32Dispatcher;
 
 #include "utilities.h"
+#include "statistics.h"
+#include "profiling.h"
+#include "pool.h"
 #include "clipboard.h"
 #include "wrappers.h"
 #include "device-context.h"
+#include "text-metrics.h"
 #include "layout.h"
 #include "window.h"
 #include "container.h"
 #include "application-window.h"
+#include "invoke.h"
+#include "dispatcher.h"
+#include "task.h"
+#include "main-loop.h"
 #include "control.h"
 #include "button.h"
 #include "label.h"
 #include "edit.h"
+#include "list-view.h"
+#include "tree-view.h"
 
 #endif
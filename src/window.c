@@ -7,82 +7,275 @@
 
 static gpointer win32_window_parent_class = NULL;
 static void win32_window_auto_resize_default (Win32Window *self, const void *data);
+static void win32_window_realize_default (Win32Window *self);
 static void  win32_window_finalize (Win32Window * obj);
 static GType win32_window_get_type_once (void);
 
 
 /* METHOD
 ------------------------------------------- */
-int win32_window_add_listener( Win32Window *self,
-                               UINT eventID,
-                               Win32Callback callback,
-                               void *boundData,
-                               Win32ReleaseFunction releaseData )
+// Returns a handle to remove the listener with, 0 on failure. Listeners added
+// with LISTENER_COALESCE receive a single event, the latest one, per message
+// loop turn; during live resize once a frame.
+guint win32_window_add_listener( Win32Window *self,
+                                 UINT eventID,
+                                 Win32Callback callback,
+                                 void *boundData,
+                                 Win32ReleaseFunction releaseData,
+                                 guint flags )
 {
-    return WIN32_WINDOW_GET_CLASS (self)->add_listener (self, eventID, callback, boundData, releaseData);
+    return WIN32_WINDOW_GET_CLASS (self)->add_listener (self, eventID, callback, boundData, releaseData, flags);
 }
 
 
-/* INTERNAL INSERT CALLBACK
+/* INTERNAL EVENT LOOKUP
 ------------------------------------------- */
-int win32_window_insert_into_callback_queue ( Win32Window *self,
-                                              UINT eventID,
-                                              Win32Callback callback,
-                                              void *boundData,
-                                              Win32ReleaseFunction releaseData )
+static inline size_t win32_event_hash (UINT eventID, UINT indexShift)
 {
-    Win32Window * window = (Win32Window*) self;
-    Win32EventList * eventList = &window->attachedEvents;
-    size_t num_ev = eventList->length;
-    // Check if we have enough room in the list
-    if ( (num_ev + 1) % INITIAL_LIST_SIZE == 0 ){
-        eventList->items = realloc(eventList->items, sizeof(Win32EventListItem) * ((num_ev + 1) + INITIAL_LIST_SIZE) );
-        // Initialize newly added slots
-        memset( eventList->items + (num_ev + 1), 0, sizeof(Win32EventListItem) * INITIAL_LIST_SIZE );
+    // Fibonacci hashing, message ids are mostly small and consecutive so the
+    // slot is taken from the well mixed high bits of the product
+    return (size_t) ((UINT) (eventID * 2654435769u) >> indexShift);
+}
+
+
+/* INTERNAL EVENT LOOKUP
+------------------------------------------- */
+static Win32EventListItem *win32_event_list_find (Win32EventList *eventList, UINT eventID)
+{
+    // Messages without listeners leave here without touching the list
+    if ( !(eventList->filter & ((guint64) 1 << (eventID % 64))) ) return NULL;
+
+    size_t mask = eventList->indexSize - 1;
+    size_t slot = win32_event_hash (eventID, eventList->indexShift);
+    int position;
+    // [!] Assignment is intentional
+    while ( position = eventList->index[slot] ){
+        if ( eventList->items[position - 1].eventID == eventID ) return &eventList->items[position - 1];
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+
+/* INTERNAL EVENT LOOKUP
+------------------------------------------- */
+// Adds the event at the given position of the list to the hash table
+static void win32_event_list_index (Win32EventList *eventList, size_t position)
+{
+    // Keep the load factor below 1/2, the table is rebuilt as it grows
+    if ( eventList->length * 2 > eventList->indexSize ){
+        free (eventList->index);
+        eventList->indexSize = eventList->indexSize ? eventList->indexSize * 2 : INITIAL_LIST_SIZE;
+        eventList->indexShift = 32;
+        for (size_t size=eventList->indexSize; size>1; size/=2) eventList->indexShift -= 1;
+        eventList->index = malloc( sizeof(int) * eventList->indexSize );
+        memset( eventList->index, 0, sizeof(int) * eventList->indexSize );
+        for (size_t i=0; i<eventList->length; i++) win32_event_list_index (eventList, i);
+        return;
+    }
+
+    UINT eventID = eventList->items[position].eventID;
+    size_t slot = win32_event_hash (eventID, eventList->indexShift);
+    while ( eventList->index[slot] ) slot = (slot + 1) & (eventList->indexSize - 1);
+
+    eventList->index[slot] = position + 1;
+    eventList->filter |= (guint64) 1 << (eventID % 64);
+}
+
+
+/* INTERNAL LISTENER HANDLES
+------------------------------------------- */
+static guint win32_event_list_new_handle (Win32EventList *eventList, size_t event, size_t listener)
+{
+    size_t slot;
+
+    if ( eventList->freeSlot ){
+        slot = eventList->freeSlot - 1;
+        eventList->freeSlot = eventList->slots[slot].listener;
+    } else {
+        // Out of handles
+        if ( eventList->numSlots == LISTENER_SLOT_MASK ) return 0;
+
+        if ( eventList->numSlots == eventList->slotCapacity ){
+            eventList->slotCapacity = eventList->slotCapacity ? eventList->slotCapacity * 2 : INITIAL_LIST_SIZE;
+            eventList->slots = realloc( eventList->slots, sizeof(Win32ListenerSlot) * eventList->slotCapacity );
+        }
+        slot = eventList->numSlots++;
+        eventList->slots[slot].generation = 0;
     }
+    eventList->slots[slot].event    = event;
+    eventList->slots[slot].listener = listener;
+    eventList->slots[slot].inUse    = TRUE;
 
+    return ((eventList->slots[slot].generation & LISTENER_GENERATION_MASK) << LISTENER_SLOT_BITS) | (guint) (slot + 1);
+}
+
+
+/* INTERNAL LISTENER HANDLES
+------------------------------------------- */
+static Win32ListenerSlot *win32_event_list_get_slot (Win32EventList *eventList, guint handle)
+{
+    size_t slot = handle & LISTENER_SLOT_MASK;
+    if ( slot == 0 || slot > eventList->numSlots ) return NULL;
+
+    Win32ListenerSlot *listenerSlot = &eventList->slots[slot - 1];
+    if ( !listenerSlot->inUse || (listenerSlot->generation & LISTENER_GENERATION_MASK) != handle >> LISTENER_SLOT_BITS )
+        return NULL;
+
+    return listenerSlot;
+}
+
+
+/* INTERNAL LISTENER HANDLES
+------------------------------------------- */
+static void win32_event_list_free_slot (Win32EventList *eventList, size_t slot)
+{
+    eventList->slots[slot].inUse = FALSE;
+    eventList->slots[slot].generation += 1;
+    eventList->slots[slot].listener = eventList->freeSlot;
+    eventList->freeSlot = slot + 1;
+}
+
+
+/* INTERNAL EVENT LIST COMPACTION
+------------------------------------------- */
+// Drops the removed listeners of the event at the given position, releasing the
+// data of the ones removed during dispatch
+static void win32_event_list_compact (Win32EventList *eventList, size_t position)
+{
+    Win32EventListItem *event = &eventList->items[position];
+    Win32Listener *listener;
+    size_t live = 0;
+
+    for (size_t n=0; n<event->numListeners; n++)
+    {
+        listener = &event->listeners[n];
+        if ( listener->callback == NULL ){
+            if ( listener->releaseData ) listener->releaseData( listener->boundData );
+            continue;
+        }
+        if ( live != n ){
+            event->listeners[live] = *listener;
+            eventList->slots[ (listener->handle & LISTENER_SLOT_MASK) - 1 ].listener = live;
+        }
+        live += 1;
+    }
+    event->numListeners = live;
+    event->numRemoved = 0;
+}
+
+
+/* INTERNAL EVENT LIST CLEANUP
+------------------------------------------- */
+// Releases the bound data of every listener and empties the list
+static void win32_event_list_clear (Win32EventList *eventList)
+{
     Win32EventListItem *events = eventList->items;
+    Win32Listener *listener;
+
+    for (size_t i=0; i<eventList->length; i++){
+        for (size_t n=0; n<events[i].numListeners; n++){
+            listener = &events[i].listeners[n];
+            if ( listener->releaseData ) listener->releaseData( listener->boundData );
+        }
+        free(events[i].listeners);
+    }
+    // A dispatch loop in progress finds the queues empty
+    if ( events ) memset( events, 0, sizeof(Win32EventListItem) * eventList->length );
+    eventList->length = 0;
+    // Nothing is dispatched after this point
+    eventList->filter = 0;
+    if ( eventList->index ) memset( eventList->index, 0, sizeof(int) * eventList->indexSize );
+
+    // Invalidate the handles
+    for (size_t slot=0; slot<eventList->numSlots; slot++){
+        if ( eventList->slots[slot].inUse ) win32_event_list_free_slot (eventList, slot);
+    }
+    eventList->needsCompaction = FALSE;
+}
+
+
+/* INTERNAL INSERT CALLBACK
+------------------------------------------- */
+guint win32_window_insert_into_callback_queue ( Win32Window *self,
+                                                UINT eventID,
+                                                Win32Callback callback,
+                                                void *boundData,
+                                                Win32ReleaseFunction releaseData,
+                                                guint flags )
+{
+    Win32Window * window = (Win32Window*) self;
+    Win32EventList * eventList = &window->attachedEvents;
 
     // Find the event's index in the list.
     // If it's not already in the list, it'll be appended to the list
-    int i = 0;
-    while ( events[i].eventID != WM_NULL && events[i].eventID != eventID ) i++;
+    Win32EventListItem *event = win32_event_list_find (eventList, eventID);
 
-    if ( events[i].callbacks == NULL ){
-        events[i].callbacks = malloc( sizeof(Win32Callback) * INITIAL_QUEUE_SIZE );
-        memset( events[i].callbacks, 0, sizeof(Win32Callback) * INITIAL_QUEUE_SIZE );
-        // Check if memory allocation fails
-        events[i].boundData = malloc( sizeof(void*) * INITIAL_QUEUE_SIZE );
-        memset( events[i].boundData, 0, sizeof(void*) * INITIAL_QUEUE_SIZE );
+    if ( event == NULL ){
+        // Grow the list geometrically
+        if ( eventList->length == eventList->capacity ){
+            eventList->capacity = eventList->capacity ? eventList->capacity * 2 : INITIAL_LIST_SIZE;
+            eventList->items = realloc( eventList->items, sizeof(Win32EventListItem) * eventList->capacity );
+        }
+        event = &eventList->items[eventList->length];
+        memset( event, 0, sizeof(Win32EventListItem) );
+        event->eventID = eventID;
 
-        events[i].releaseData = malloc( sizeof(void*) * INITIAL_QUEUE_SIZE );
-        memset( events[i].releaseData, 0, sizeof(void*) * INITIAL_QUEUE_SIZE );
+        eventList->length += 1;
+        win32_event_list_index (eventList, eventList->length - 1);
     }
 
-    size_t num_cb = events[i].numCallbacks;
-
-    // Check if we have enough room in the callback queue
-    if ( (num_cb + 1) % INITIAL_QUEUE_SIZE == 0 ){
-        events[i].callbacks = realloc(events[i].callbacks, sizeof(Win32Callback) * ((num_cb + 1) + INITIAL_QUEUE_SIZE) );
-        events[i].boundData = realloc(events[i].boundData, sizeof(void*) * ((num_cb + 1) + INITIAL_QUEUE_SIZE) );
-        events[i].releaseData = realloc(events[i].releaseData, sizeof(void*) * ((num_cb + 1) + INITIAL_QUEUE_SIZE) );
-        // Initialize newly added slots
-        memset( events[i].callbacks + (num_cb + 1), 0, sizeof(Win32Callback) * INITIAL_QUEUE_SIZE );
-        memset( events[i].boundData + (num_cb + 1), 0, sizeof(void*) * INITIAL_QUEUE_SIZE );
-        memset( events[i].releaseData + (num_cb + 1), 0, sizeof(void*) * INITIAL_QUEUE_SIZE );
+    // Check if we have enough room in the listener queue
+    if ( event->numListeners == event->capacity ){
+        event->capacity = event->capacity ? event->capacity * 2 : INITIAL_QUEUE_SIZE;
+        event->listeners = realloc( event->listeners, sizeof(Win32Listener) * event->capacity );
     }
 
-    // We're adding a new event to the list so increase the item count
-    if (events[i].eventID == 0 ){
-        events[i].eventID = eventID;
-        eventList->length += 1;
+    guint handle = win32_event_list_new_handle (eventList, event - eventList->items, event->numListeners);
+    if ( handle == 0 ) return 0;
+
+    Win32Listener *listener = &event->listeners[event->numListeners];
+    listener->callback    = callback;
+    listener->boundData   = boundData;
+    listener->releaseData = releaseData;
+    listener->handle      = handle;
+    listener->flags       = flags;
+    // increase listener number
+    event->numListeners += 1;
+    if ( flags & LISTENER_COALESCE ) event->numCoalesced += 1;
+    return handle;
+}
+
+
+/* METHOD
+------------------------------------------- */
+// Removal is safe during dispatch: the listener is replaced by a tombstone and
+// the queue is compacted once no dispatch loop is running on the window.
+BOOL win32_window_remove_listener (Win32Window *self, guint handle)
+{
+    Win32EventList * eventList = &self->attachedEvents;
+    Win32ListenerSlot *slot = win32_event_list_get_slot (eventList, handle);
+    if ( slot == NULL ) return FALSE;
+
+    size_t position = slot->event;
+    Win32EventListItem *event = &eventList->items[position];
+    Win32Listener *listener = &event->listeners[slot->listener];
+
+    listener->callback = NULL;
+    event->numRemoved += 1;
+    if ( listener->flags & LISTENER_COALESCE ) event->numCoalesced -= 1;
+    win32_event_list_free_slot (eventList, slot - eventList->slots);
+
+    // The callback may be running, its data is released after dispatch
+    if ( eventList->dispatching ){
+        eventList->needsCompaction = TRUE;
+        return TRUE;
     }
 
-    events[i].callbacks[num_cb] = callback;
-    events[i].boundData[num_cb] = boundData;
-    events[i].releaseData[num_cb] = releaseData;
-    // increase callback number
-    events[i].numCallbacks += 1;
+    if ( listener->releaseData ) listener->releaseData( listener->boundData );
+    listener->releaseData = NULL;
+    // Compact once half of the queue is tombstones, which keeps removal amortized O(1)
+    if ( event->numRemoved * 2 >= event->numListeners ) win32_event_list_compact (eventList, position);
     return TRUE;
 }
 
@@ -98,13 +291,76 @@ LRESULT invoke_callback (Win32Window *window, UINT msg, WPARAM wParam, LPARAM lP
     event.lParam  = lParam;
     event.handled = 0; // Hand over the event to the default window procedure after processing it
 
+    WIN32_PROFILE_BEGIN (start);
     callback( &event, boundData );
+    WIN32_PROFILE_END (WIN32_TIMER_CALLBACK, start);
 
     if ( event.handled == 1 ) return STOP_PROPAGATION;
     else return 0;
 }
 
 
+/* INTERNAL DISPATCH
+------------------------------------------- */
+// Runs either the immediate or the coalescing listeners of the event at the given position
+static LRESULT win32_window_dispatch (Win32Window *window, size_t position, WPARAM wParam, LPARAM lParam, guint coalesced)
+{
+    Win32EventList *eventList = &window->attachedEvents;
+    UINT msg = eventList->items[position].eventID;
+    LRESULT result = 0;
+    Win32Listener listener;
+
+    // Callbacks may add listeners, the arrays are re-read after every call
+    eventList->dispatching += 1;
+    for (size_t n=0; n<eventList->items[position].numListeners; n++){
+        listener = eventList->items[position].listeners[n];
+        // Skip the removed listeners
+        if ( listener.callback == NULL || (listener.flags & LISTENER_COALESCE) != coalesced ) continue;
+        result = invoke_callback( window, msg, wParam, lParam, listener.callback, listener.boundData);
+    }
+    eventList->dispatching -= 1;
+
+    // Compact the queues the callbacks removed listeners from
+    if ( eventList->dispatching == 0 && eventList->needsCompaction ){
+        eventList->needsCompaction = FALSE;
+        for (size_t i=0; i<eventList->length; i++){
+            if ( eventList->items[i].numRemoved ) win32_event_list_compact (eventList, i);
+        }
+    }
+    return result;
+}
+
+
+/* INTERNAL COALESCING
+------------------------------------------- */
+static void win32_window_schedule_flush (Win32Window *window)
+{
+    Win32EventList *eventList = &window->attachedEvents;
+    if ( eventList->flushScheduled ) return;
+
+    eventList->flushScheduled = TRUE;
+    // The frame timer delivers the events during live resize
+    if ( !eventList->sizing ) PostMessage (window->hwnd, FM_COALESCED, 0, 0);
+}
+
+
+/* INTERNAL COALESCING
+------------------------------------------- */
+// Delivers the latest payload of every pending coalesced event
+void win32_window_flush_coalesced (Win32Window *window)
+{
+    Win32EventList *eventList = &window->attachedEvents;
+    if ( !eventList->flushScheduled ) return;
+    eventList->flushScheduled = FALSE;
+
+    for (size_t i=0; i<eventList->length; i++){
+        if ( !eventList->items[i].pending ) continue;
+        eventList->items[i].pending = FALSE;
+        win32_window_dispatch (window, i, eventList->items[i].wParam, eventList->items[i].lParam, LISTENER_COALESCE);
+    }
+}
+
+
 /* INTERNAL DEFAULT WINDOW PROCEDURE
 ------------------------------------------- */
 LRESULT win32_window_default_procedure(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
@@ -124,49 +380,75 @@ LRESULT win32_window_default_procedure(HWND hwnd, UINT msg, WPARAM wParam, LPARA
         window->hwnd = hwnd;
         SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR) window);
     } else if ( msg == WM_DESTROY ){
-        // Clear event list
-        Win32ReleaseFunction bound_data_unref;
-
-        if (events != NULL){
-            int i = 0, n;
-            // events array is a null terminated list
-            while ( events[i].eventID != WM_NULL ){
-                // callbacks array is a null terminated list
-                n = 0;
-                while ( events[i].callbacks[n] != NULL ){
-                    if ( events[i].releaseData[n] ){
-                        bound_data_unref = events[i].releaseData[n];
-                        bound_data_unref( events[i].boundData[n] );
-                    }
-                    n += 1;
+        // Clear event list, unless only the HWND goes away
+        if (events != NULL && !window->unrealizing) win32_event_list_clear (eventList);
+    } else if ( window != NULL ){
+        // Coalesced events are delivered at display rate during live resize
+        switch (msg){
+            case WM_CREATE:
+                // Create the children constructed in advance, before the listeners run
+                WIN32_WINDOW_GET_CLASS (window)->realize (window);
+                break;
+
+            case WM_SETTEXT:
+                window->textCached = FALSE;
+                break;
+
+            case FM_COMMAND:
+                // The user typed into an edit control
+                if ( HIWORD (wParam) == EN_CHANGE ) window->textCached = FALSE;
+                break;
+
+            case FM_COALESCED:
+                win32_window_flush_coalesced (window);
+                return STOP_PROPAGATION;
+
+            case WM_TIMER:
+                if ( wParam != COALESCE_TIMER_ID ) break;
+                win32_window_flush_coalesced (window);
+                return STOP_PROPAGATION;
+
+            case WM_ENTERSIZEMOVE:
+                eventList->sizing = TRUE;
+                SetTimer (hwnd, COALESCE_TIMER_ID, COALESCE_INTERVAL, NULL);
+                break;
+
+            case WM_EXITSIZEMOVE:
+                eventList->sizing = FALSE;
+                KillTimer (hwnd, COALESCE_TIMER_ID);
+                win32_window_flush_coalesced (window);
+                break;
+
+            case WM_WINDOWPOSCHANGED: {
+                // Keep the geometry cache up to date, whoever moved the window
+                WINDOWPOS *position = (WINDOWPOS*) lParam;
+                if ( !(position->flags & SWP_NOMOVE) ){
+                    window->left = position->x;
+                    window->top  = position->y;
+                }
+                if ( !(position->flags & SWP_NOSIZE) ){
+                    window->width  = position->cx;
+                    window->height = position->cy;
                 }
-                free(events[i].callbacks);
-                free(events[i].boundData);
-                free(events[i].releaseData);
-                i += 1;
-            }
-            memset( eventList->items, 0, sizeof(Win32EventListItem) * eventList->length );
-            eventList->length = 0;
+                break; }
         }
     }// END IF
 
     LRESULT result = 0;
+    Win32EventListItem *event;
     // To prevent memory access issues before the list is initialized
-    if (events != NULL){
-        int i = 0, n = 0;
-        // events array is a null terminated list
-        while ( events[i].eventID != WM_NULL ){
-            // Check if the event has a registered callback
-            if ( events[i].eventID == msg){
-                // callbacks array is a null terminated list
-                while ( events[i].callbacks[n] != NULL ){
-                    result = invoke_callback( window, msg, wParam, lParam, events[i].callbacks[n], events[i].boundData[n]);
-                    n += 1;
-                }
-                break; // No need to check further events in the list
-            }
-            i += 1;
+    // [!] Assignment is intentional
+    if ( events != NULL && (event = win32_event_list_find (eventList, msg)) ){
+        size_t position = event - eventList->items;
+        // Keep the latest payload for the coalescing listeners
+        if ( event->numCoalesced ){
+            event->pending = TRUE;
+            event->wParam  = wParam;
+            event->lParam  = lParam;
+            win32_window_schedule_flush (window);
         }
+        if ( event->numListeners - event->numRemoved > event->numCoalesced )
+            result = win32_window_dispatch (window, position, wParam, lParam, LISTENER_NONE);
     }// END IF
     return result;
 }
@@ -184,6 +466,9 @@ void win32_window_set_positioning (Win32Window *instance, Win32LayoutData* layou
 
     // increase reference count
     instance->positioning = win32_layout_data_ref( layoutData );
+    // the window has to be placed from scratch by the layout
+    win32_layout_data_invalidate( layoutData, EDGE_ALL );
+    layoutData->_reanchored = TRUE;
 }
 
 
@@ -195,22 +480,53 @@ Win32LayoutData*  win32_window_get_positioning (Win32Window *window)
 }
 
 
-/* PROPERTY SET LEFT
+/* INTERNAL GEOMETRY
 ------------------------------------------- */
-void  win32_window_set_left (Win32Window *window, int left)
+// The left, top, width and height fields hold the outer rectangle of the window
+// relative to its parent. They're kept up to date from WM_WINDOWPOSCHANGED, so
+// reading them never reaches USER32; this one seeds them after creation.
+void win32_window_sync_geometry (Win32Window *window)
 {
-    window->left = left;
+    RECT rect;
+    if ( window->hwnd == NULL ) return;
 
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
+    WIN32_COUNT_CALL (WIN32_CALL_GET_WINDOW_RECT);
+    GetWindowRect( window->hwnd, &rect );
+
+    HWND parent = GetParent( window->hwnd );
+    if ( parent != NULL ){
+        WIN32_COUNT_CALL (WIN32_CALL_MAP_WINDOW_POINTS);
+        MapWindowPoints( HWND_DESKTOP, parent, (LPPOINT) &rect, 2);
+    }
+    window->left   = rect.left;
+    window->top    = rect.top;
+    window->width  = rect.right - rect.left;
+    window->height = rect.bottom - rect.top;
+}
 
-        int height = rect.bottom - rect.top;
-        int width  = rect.right - rect.left;
 
-        MoveWindow( window->hwnd, left, rect.top, width, height, /*REPAINT*/ TRUE );
+/* INTERNAL GEOMETRY
+------------------------------------------- */
+static void win32_window_set_geometry (Win32Window *window, int left, int top, int width, int height, UINT flags)
+{
+    // The fields are up to date already, the window is moved once the update ends
+    if ( win32_window_is_updating (window) ){
+        window->pendingGeometry = TRUE;
+        return;
     }
+    WIN32_COUNT_CALL (WIN32_CALL_SET_WINDOW_POS);
+    SetWindowPos( window->hwnd, NULL, left, top, width, height, flags | SWP_NOZORDER | SWP_NOACTIVATE );
+}
+
+
+/* PROPERTY SET LEFT
+------------------------------------------- */
+void  win32_window_set_left (Win32Window *window, int left)
+{
+    window->left = left;
+    win32_layout_data_invalidate( window->positioning, EDGE_ALL );
+
+    if (window->hwnd != NULL) win32_window_set_geometry( window, left, window->top, 0, 0, SWP_NOSIZE );
 }
 
 
@@ -218,13 +534,6 @@ void  win32_window_set_left (Win32Window *window, int left)
 ------------------------------------------- */
 int   win32_window_get_left (Win32Window *window)
 {
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-
-        window->left = rect.left;
-    }
     return window->left;
 }
 
@@ -234,17 +543,9 @@ int   win32_window_get_left (Win32Window *window)
 void  win32_window_set_top (Win32Window *window, int top)
 {
     window->top = top;
+    win32_layout_data_invalidate( window->positioning, EDGE_ALL );
 
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-
-        int height = rect.bottom - rect.top;
-        int width  = rect.right - rect.left;
-
-        MoveWindow( window->hwnd, rect.left, top, width, height, /*REPAINT*/ TRUE );
-    }
+    if (window->hwnd != NULL) win32_window_set_geometry( window, window->left, top, 0, 0, SWP_NOSIZE );
 }
 
 
@@ -252,12 +553,6 @@ void  win32_window_set_top (Win32Window *window, int top)
 ------------------------------------------- */
 int   win32_window_get_top (Win32Window *window)
 {
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-        window->top = rect.top;
-    }
     return window->top;
 }
 
@@ -267,15 +562,11 @@ int   win32_window_get_top (Win32Window *window)
 void  win32_window_set_width (Win32Window *window, int width)
 {
     window->pref_width = width;
+    win32_layout_data_invalidate( window->positioning, EDGE_ALL );
 
     if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-
-        int height = rect.bottom - rect.top;
-
-        MoveWindow( window->hwnd, rect.left, rect.top, width, height, /*REPAINT*/ TRUE );
+        window->width = width;
+        win32_window_set_geometry( window, 0, 0, width, window->height, SWP_NOMOVE );
     }
 }
 
@@ -284,15 +575,7 @@ void  win32_window_set_width (Win32Window *window, int width)
 ------------------------------------------- */
 int   win32_window_get_width (Win32Window *window)
 {
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-
-        int width = rect.right - rect.left;
-        return window->width = width;
-    }
-    return window->pref_width;
+    return (window->hwnd != NULL) ? window->width : window->pref_width;
 }
 
 
@@ -301,15 +584,11 @@ int   win32_window_get_width (Win32Window *window)
 void  win32_window_set_height (Win32Window *window, int height)
 {
     window->pref_height = height;
+    win32_layout_data_invalidate( window->positioning, EDGE_ALL );
 
     if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-
-        int width = rect.right - rect.left;
-
-        MoveWindow( window->hwnd, rect.left, rect.top, width, height, /*REPAINT*/ TRUE );
+        window->height = height;
+        win32_window_set_geometry( window, 0, 0, window->width, height, SWP_NOMOVE );
     }
 }
 
@@ -318,15 +597,7 @@ void  win32_window_set_height (Win32Window *window, int height)
 ------------------------------------------- */
 int   win32_window_get_height (Win32Window *window)
 {
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect );
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-
-        int height = rect.bottom - rect.top;
-        return window->height = height;
-    }
-    return window->pref_height;
+    return (window->hwnd != NULL) ? window->height : window->pref_height;
 }
 
 
@@ -335,18 +606,20 @@ int   win32_window_get_height (Win32Window *window)
 void  win32_window_set_text (Win32Window *window, const char* text)
 {
     char* tmp0;
-    wchar_t* tmp1;
+    Win32WideString tmp1;
     tmp0 = window->text;
     window->text = _strdup (text);
-    tmp1 = fromUTF8( window->text );
 
     if (window->hwnd != NULL){
-        SetWindowText( window->hwnd, tmp1);
+        win32_wide_string_init( &tmp1, window->text );
+        SetWindowText( window->hwnd, tmp1.str);
         if (window->auto_resize){
-            WIN32_WINDOW_GET_CLASS(window)->auto_resize(window, tmp1);
+            WIN32_WINDOW_GET_CLASS(window)->auto_resize(window, tmp1.str);
         }
+        win32_wide_string_release( &tmp1 );
     }
-    free (tmp1);
+    // after SetWindowText, which invalidates the cache
+    window->textCached = TRUE;
     free (tmp0);
 }
 
@@ -357,19 +630,44 @@ char* win32_window_get_text (Win32Window *window)
 {
     if (window->hwnd == NULL) return window->text;
 
+    // The text is fetched again only when it changed since the last read
+    if ( window->textCached && window->text != NULL ){
+        WIN32_COUNT_CACHE (WIN32_CACHE_TEXT_HIT);
+        return window->text;
+    }
+    WIN32_COUNT_CACHE (WIN32_CACHE_TEXT_MISS);
+    window->textCached = TRUE;
+
+    WIN32_COUNT_CALL (WIN32_CALL_GET_WINDOW_TEXT_LENGTH);
     int bufferSize = GetWindowTextLength(window->hwnd);
 
-    if ( bufferSize == 0 ) return ""; //NULL;
+    if ( bufferSize == 0 ){
+        free (window->text);
+        window->text = _strdup ("");
+        return window->text;
+    }
 
-    wchar_t * buffer = malloc( sizeof(wchar_t) * (bufferSize+1) );
-    memset(buffer, 0, sizeof(wchar_t) * (bufferSize+1) );
-    GetWindowText(window->hwnd, buffer, bufferSize+1);
+    wchar_t stackBuffer[WIDE_STRING_BUFFER_SIZE];
+    wchar_t * buffer = stackBuffer;
+    if ( bufferSize >= WIDE_STRING_BUFFER_SIZE ){
+        buffer = malloc( sizeof(wchar_t) * (bufferSize+1) );
+    }
+    WIN32_COUNT_CALL (WIN32_CALL_GET_WINDOW_TEXT);
+    bufferSize = GetWindowText(window->hwnd, buffer, bufferSize+1);
 
     char * tmp0 = window->text;
-    window->text = toUTF8( buffer );
+    char * text = malloc( UTF8_MAX_LENGTH(bufferSize) + 1 );
+    size_t written = win32_utf16_to_utf8 ((const uint16_t*) buffer, bufferSize, text);
+    text[written] = 0;
+    // the cache keeps the text, give the unused part of the estimate back
+    if ( written < UTF8_MAX_LENGTH(bufferSize) ){
+        char *shrunk = realloc (text, written + 1);
+        if (shrunk) text = shrunk;
+    }
+    window->text = text;
 
     free (tmp0);
-    free (buffer);
+    if ( buffer != stackBuffer ) free (buffer);
 
     return window->text;
 }
@@ -398,22 +696,38 @@ BOOL  win32_window_get_enabled (Win32Window *self)
 }
 
 
+/* PROPERTY SET VISIBLE
+------------------------------------------- */
+void  win32_window_set_visible (Win32Window *self, BOOL isVisible)
+{
+    self->visible = isVisible;
+
+    if (self->hwnd != NULL){
+        ShowWindow(self->hwnd, isVisible ? SW_SHOWNA : SW_HIDE);
+    } else if ( isVisible && self->parent != NULL && self->parent->hwnd != NULL ){
+        // A lazily realized control is created once it is shown
+        WIN32_WINDOW_GET_CLASS(self->parent)->realize(self->parent);
+    }
+}
+
+
+/* PROPERTY GET VISIBLE
+------------------------------------------- */
+BOOL  win32_window_get_visible (Win32Window *self)
+{
+    return self->visible;
+}
+
+
 /* METHOD
 ------------------------------------------- */
 void win32_window_move (Win32Window *window, int left, int top)
 {
     window->left = left;
     window->top  = top;
+    win32_layout_data_invalidate( window->positioning, EDGE_ALL );
 
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetWindowRect( window->hwnd, &rect);
-
-        int height = rect.bottom - rect.top;
-        int width  = rect.right - rect.left;
-
-        MoveWindow( window->hwnd, left, top, width, height, /*REPAINT*/ TRUE );
-    }
+    if (window->hwnd != NULL) win32_window_set_geometry( window, left, top, 0, 0, SWP_NOSIZE );
 }
 
 
@@ -423,13 +737,9 @@ void win32_window_resize (Win32Window *window, int width, int height)
 {
     window->width  = width;
     window->height = height;
+    win32_layout_data_invalidate( window->positioning, EDGE_ALL );
 
-    if (window->hwnd != NULL){
-        RECT rect;
-        GetClientRect( window->hwnd, &rect);
-        MapWindowPoints( window->hwnd, GetParent(window->hwnd), (LPPOINT) &rect, 2);
-        MoveWindow( window->hwnd, rect.left, rect.top, width, height, /*REPAINT*/ TRUE );
-    }
+    if (window->hwnd != NULL) win32_window_set_geometry( window, 0, 0, width, height, SWP_NOMOVE );
 }
 
 
@@ -442,12 +752,114 @@ void win32_window_move_and_resize  (Win32Window *window, int left, int top, int
     window->width  = width;
     window->height = height;
 
-    if (window->hwnd != NULL){
-        RECT *rect = malloc( sizeof(RECT) );
-        GetWindowRect( window->hwnd, rect);
-        MoveWindow( window->hwnd, left, top, width, height, /*REPAINT*/ TRUE );
-        free (rect);
+    if (window->hwnd != NULL) win32_window_set_geometry( window, left, top, width, height, 0 );
+}
+
+
+/* METHOD BEGIN UPDATE
+------------------------------------------- */
+// Until the matching end_update call, the window and its children are not
+// redrawn and their geometry changes are only recorded. Calls can be nested.
+void win32_window_begin_update (Win32Window *window)
+{
+    window->updateDepth += 1;
+    if ( window->updateDepth > 1 || window->hwnd == NULL ) return;
+
+    // WM_SETREDRAW toggles WS_VISIBLE, a hidden window is left alone
+    if ( !IsWindowVisible( window->hwnd ) ) return;
+
+    WIN32_COUNT_CALL (WIN32_CALL_SET_REDRAW);
+    SendMessage( window->hwnd, WM_SETREDRAW, FALSE, 0 );
+    window->redrawFrozen = TRUE;
+}
+
+
+/* METHOD END UPDATE
+------------------------------------------- */
+// Applies the recorded geometry changes, one per window, and repaints the window
+// once. Returns the number of Win32 calls the update issued.
+guint win32_window_end_update (Win32Window *window)
+{
+    if ( window->updateDepth == 0 ) return 0;
+    window->updateDepth -= 1;
+    if ( window->updateDepth > 0 ) return 0;
+
+    gulong numCalls = win32_statistics_get_total_calls ();
+    // Inside the update of a parent, the parent applies the changes and repaints
+    BOOL nested = win32_window_is_updating (window);
+
+    if ( !nested ){
+        HDWP transaction = NULL;
+        WIN32_WINDOW_GET_CLASS (window)->flush_geometry (window, &transaction);
+        if ( transaction != NULL ) EndDeferWindowPos (transaction);
+    }
+
+    if ( window->redrawFrozen ){
+        window->redrawFrozen = FALSE;
+        WIN32_COUNT_CALL (WIN32_CALL_SET_REDRAW);
+        SendMessage( window->hwnd, WM_SETREDRAW, TRUE, 0 );
+
+        if ( !nested ){
+            WIN32_COUNT_CALL (WIN32_CALL_REDRAW_WINDOW);
+            RedrawWindow( window->hwnd, NULL, NULL, RDW_ERASE | RDW_FRAME | RDW_INVALIDATE | RDW_ALLCHILDREN );
+        }
+    }
+    return win32_statistics_get_total_calls () - numCalls;
+}
+
+
+/* INTERNAL UPDATE
+------------------------------------------- */
+BOOL win32_window_is_updating (Win32Window *window)
+{
+    // An update on a container covers its children too
+    for ( ; window != NULL; window = window->parent ){
+        if ( window->updateDepth > 0 ) return TRUE;
+    }
+    return FALSE;
+}
+
+
+/* INTERNAL VIRTUAL METHOD
+------------------------------------------- */
+// Adds the recorded geometry of the window to the transaction, which is started
+// on demand. Containers override this to flush their children as well.
+void win32_window_flush_geometry (Win32Window *window, HDWP *transaction)
+{
+    if ( !window->pendingGeometry || window->hwnd == NULL ) return;
+    window->pendingGeometry = FALSE;
+
+    if ( *transaction == NULL ) *transaction = BeginDeferWindowPos (1);
+    if ( *transaction != NULL ){
+        WIN32_COUNT_CALL (WIN32_CALL_DEFER_WINDOW_POS);
+        *transaction = DeferWindowPos( *transaction, window->hwnd, NULL, window->left, window->top,
+                                       window->width, window->height, SWP_NOZORDER | SWP_NOACTIVATE );
+        if ( *transaction != NULL ) return;
     }
+    // A failed transaction is discarded, the window is moved on its own
+    WIN32_COUNT_CALL (WIN32_CALL_SET_WINDOW_POS);
+    SetWindowPos( window->hwnd, NULL, window->left, window->top, window->width, window->height,
+                  SWP_NOZORDER | SWP_NOACTIVATE );
+}
+
+
+/* INTERNAL UPDATE LAYOUT
+------------------------------------------- */
+// Lets the parent's layout re-arrange the window and the siblings depending on it.
+// Returns FALSE if the window is not managed by a layout.
+BOOL win32_window_update_layout (Win32Window *window)
+{
+    Win32Container *parent = (Win32Container*) window->parent;
+
+    win32_layout_data_invalidate( window->positioning, EDGE_ALL );
+    if ( parent == NULL || parent->layout == NULL || window->parent->hwnd == NULL ) return FALSE;
+    // A container creating its children lays them out once it is done
+    if ( parent->realizing ) return TRUE;
+
+    WIN32_PROFILE_BEGIN (start);
+    parent->layout->recalculate (parent);
+    WIN32_PROFILE_END (WIN32_TIMER_LAYOUT, start);
+    return TRUE;
 }
 
 
@@ -466,27 +878,52 @@ void win32_window_end_paint(Win32Window *window, PAINTSTRUCT *ps)
     EndPaint (window->hwnd, ps);
 }
 
-/* METHOD
+/* METHOD GET WINDOW RECT
 ------------------------------------------- */
-Win32Rect* win32_window_get_window_rect(Win32Window *window)
+// Fills the caller's rect with the screen coordinates of the window, an empty
+// rect when the window isn't created
+BOOL win32_window_get_window_rect (Win32Window *window, RECT *rect)
 {
-    Win32Rect *result = malloc( sizeof(Win32Rect) );
-    memset( result, 0, sizeof(Win32Rect) );
-    g_atomic_int_inc (&result->ref_count);
-    if ( GetWindowRect( window->hwnd, (RECT*) result) ) return result;
-    else return NULL;
+    WIN32_COUNT_CALL (WIN32_CALL_GET_WINDOW_RECT);
+    if ( window->hwnd != NULL && GetWindowRect( window->hwnd, rect ) ) return TRUE;
+
+    SetRectEmpty (rect);
+    return FALSE;
 }
 
 
-/* METHOD
+/* METHOD GET CLIENT RECT
 ------------------------------------------- */
-Win32Rect* win32_window_get_client_rect(Win32Window *window)
+BOOL win32_window_get_client_rect (Win32Window *window, RECT *rect)
 {
-    Win32Rect *result = malloc( sizeof(Win32Rect) );
-    memset( result, 0, sizeof(Win32Rect) );
-    g_atomic_int_inc (&result->ref_count);
-    if ( GetClientRect( window->hwnd, (RECT*) result) ) return result;
-    else return NULL;
+    WIN32_COUNT_CALL (WIN32_CALL_GET_CLIENT_RECT);
+    if ( window->hwnd != NULL && GetClientRect( window->hwnd, rect ) ) return TRUE;
+
+    SetRectEmpty (rect);
+    return FALSE;
+}
+
+
+/* METHOD GET CLIENT SIZE
+------------------------------------------- */
+// What resize handlers usually want from the client rect
+BOOL win32_window_get_client_size (Win32Window *window, SIZE *size)
+{
+    RECT rect;
+    BOOL result = win32_window_get_client_rect (window, &rect);
+    size->cx = rect.right - rect.left;
+    size->cy = rect.bottom - rect.top;
+    return result;
+}
+
+
+/* METHOD CLIENT TO SCREEN
+------------------------------------------- */
+// Converts a point in the client area of the window to screen coordinates in place
+BOOL win32_window_client_to_screen (Win32Window *window, POINT *point)
+{
+    if ( window->hwnd == NULL ) return FALSE;
+    return ClientToScreen (window->hwnd, point);
 }
 
 
@@ -498,6 +935,14 @@ void win32_window_auto_resize_default (Win32Window *self, const void *data)
 }
 
 
+/* INTERNAL VIRTUAL METHOD
+------------------------------------------- */
+static void win32_window_realize_default (Win32Window *self)
+{
+    // NO-OP
+}
+
+
 /* INTERNAL GTYPE
 ------------------------------------------- */
 static void value_win32_window_init (GValue* value)
@@ -568,6 +1013,8 @@ static void win32_window_class_init (Win32WindowClass * klass,  gpointer klass_d
     ((Win32WindowClass *) klass)->finalize = win32_window_finalize;
     ((Win32WindowClass *) klass)->auto_resize = win32_window_auto_resize_default;
     ((Win32WindowClass *) klass)->add_listener = win32_window_insert_into_callback_queue;
+    ((Win32WindowClass *) klass)->flush_geometry = win32_window_flush_geometry;
+    ((Win32WindowClass *) klass)->realize = win32_window_realize_default;
 }
 
 static void win32_window_instance_init (Win32Window * self, gpointer klass)
@@ -631,17 +1078,17 @@ Win32Window* win32_window_construct (GType object_type)
 
     self->hInstance = GetModuleHandle(NULL);
     self->enabled   = TRUE;
+    self->visible   = TRUE;
+    self->dispatcher = win32_dispatcher_get ();
 
     // Initialize callback list for the window
     Win32EventList * eventList = &self->attachedEvents;
     eventList->items = malloc( sizeof(Win32EventListItem) * INITIAL_LIST_SIZE );
-    memset( eventList->items, 0, sizeof(Win32EventListItem) * INITIAL_LIST_SIZE );
+    eventList->capacity = INITIAL_LIST_SIZE;
 
     // Layout data
     //*TODO*/ allow different structures to be used for positioning
-    self->positioning = malloc( sizeof(Win32LayoutData) );
-    memset( self->positioning, 0, sizeof(Win32LayoutData) );
-    win32_layout_data_ref (self->positioning);
+    self->positioning = win32_layout_data_new ();
 
     return self;
 }
@@ -658,15 +1105,15 @@ static void win32_window_finalize (Win32Window * obj)
     if (self->hwnd != NULL) DestroyWindow (self->hwnd);
 
     if ( self->positioning != NULL ){
-        if ( self->positioning->left != NULL ) win32_anchor_unref (self->positioning->left);
-        if ( self->positioning->top  != NULL ) win32_anchor_unref (self->positioning->top);
-        if ( self->positioning->right  != NULL ) win32_anchor_unref (self->positioning->right);
-        if ( self->positioning->bottom != NULL ) win32_anchor_unref (self->positioning->bottom);
         win32_layout_data_unref (self->positioning);
     }
     // free event queue
-    // Note: event lists are freed after WM_DESTROY message
+    // Note: event lists are cleared on WM_DESTROY, the ones of windows
+    // which were never created are cleared here
+    win32_event_list_clear (&self->attachedEvents);
     free (self->attachedEvents.items);
+    free (self->attachedEvents.index);
+    free (self->attachedEvents.slots);
 
     free (self->text);
 }
@@ -677,7 +1124,7 @@ static void win32_window_finalize (Win32Window * obj)
 void* win32_window_ref (void* instance)
 {
     Win32Window * self = instance;
-    g_atomic_int_inc (&self->ref_count);
+    WIN32_REF_INC (self->ref_count);
     return instance;
 }
 
@@ -687,7 +1134,7 @@ void* win32_window_ref (void* instance)
 void win32_window_unref (gpointer instance)
 {
     Win32Window * self = instance;
-    if (g_atomic_int_dec_and_test (&self->ref_count)) {
+    if (WIN32_REF_DEC_AND_TEST (self->ref_count)) {
         WIN32_WINDOW_GET_CLASS (self)->finalize (self);
         g_type_free_instance ((GTypeInstance *) self);
     }
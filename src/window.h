@@ -29,17 +29,62 @@ struct _Win32Event {
     BOOL handled;
 };
 
+// Listener flags
+#define LISTENER_NONE      0
+#define LISTENER_COALESCE  1  // receive only the latest of the events that arrive within a loop turn
+
+typedef struct _Win32Listener {
+    Win32Callback callback;  // NULL once the listener is removed
+    void *boundData;
+    Win32ReleaseFunction releaseData;
+    guint handle;
+    guint flags;
+} Win32Listener;
+
 typedef struct _Win32EventListItem {
     UINT eventID;
-    Win32Callback *callbacks;
-    Win32ReleaseFunction *releaseData;
-    void ** boundData;
-    size_t numCallbacks;
+    Win32Listener *listeners;
+    size_t numListeners;
+    size_t capacity;
+    size_t numRemoved;    // removed listeners waiting for compaction
+    size_t numCoalesced;  // listeners with the LISTENER_COALESCE flag
+    BOOL pending;         // the latest payload is yet to be delivered to them
+    WPARAM wParam;
+    LPARAM lParam;
 } Win32EventListItem;
 
+// A listener handle holds the index of its slot + 1 in the low bits and the
+// generation of the slot in the high ones, so stale handles are rejected.
+#define LISTENER_SLOT_BITS        20
+#define LISTENER_SLOT_MASK        ((1u << LISTENER_SLOT_BITS) - 1)
+#define LISTENER_GENERATION_MASK  ((1u << (32 - LISTENER_SLOT_BITS)) - 1)
+
+typedef struct _Win32ListenerSlot {
+    size_t event;      // position of the event in the list
+    size_t listener;   // position of the listener in the queue, next free slot + 1 if not in use
+    guint generation;
+    BOOL inUse;
+} Win32ListenerSlot;
+
+// Events are looked up by their ids through an open-addressed hash table. The
+// filter has the bit (id % 64) set for every event in the list, so messages
+// without listeners are turned away before the table is probed.
 struct _Win32EventList {
     Win32EventListItem *items;
     size_t length;
+    size_t capacity;
+    guint64 filter;
+    int *index;        // slots hold the position of the event in the list + 1, 0 if empty
+    size_t indexSize;  // number of slots, a power of two
+    UINT indexShift;   // 32 - log2(indexSize)
+    Win32ListenerSlot *slots;  // listener handles
+    size_t numSlots;
+    size_t slotCapacity;
+    size_t freeSlot;           // first free slot + 1, 0 if there is none
+    int dispatching;           // depth of the dispatch loops running on the list
+    BOOL needsCompaction;      // listeners were removed during dispatch
+    BOOL flushScheduled;       // coalesced events are waiting to be delivered
+    BOOL sizing;               // the window is in the modal size/move loop
 };
 
 #define  STOP_PROPAGATION  8000
@@ -66,6 +111,7 @@ struct _Win32Window {
     HINSTANCE hInstance;
     char* text;
     BOOL enabled;
+    BOOL visible;
     INT top;
     INT left;
     INT width;
@@ -75,24 +121,34 @@ struct _Win32Window {
     INT pref_height;
     BOOL auto_resize;
     Win32EventList attachedEvents;
+    BOOL textCached;        // text holds the current text of the window
+    int  updateDepth;       // nesting level of begin_update calls
+    BOOL pendingGeometry;   // the geometry changed during an update, yet to be applied
+    BOOL redrawFrozen;      // WM_SETREDRAW was turned off by begin_update
+    BOOL unrealizing;       // the HWND is destroyed but the window lives on, see lazy realization
+    Win32Dispatcher *dispatcher;    // of the thread the window was constructed on, never changes
 };
 
 struct _Win32WindowClass {
     GTypeClass parent_class;
     void (*finalize) (Win32Window *self);
     void (*auto_resize) (Win32Window *window, const void *data);
-    int  (*add_listener)(Win32Window *window, UINT eventID, Win32Callback callback, void * boundData, Win32ReleaseFunction releaseData);
+    guint (*add_listener)(Win32Window *window, UINT eventID, Win32Callback callback, void * boundData, Win32ReleaseFunction releaseData, guint flags);
+    void (*flush_geometry)(Win32Window *window, HDWP *transaction);
+    void (*realize)(Win32Window *window);
 };
 
 Win32Window* win32_window_new (void);
 Win32Window* win32_window_construct (GType object_type);
 
 // Window* window_new (void);
-int win32_window_add_listener (Win32Window *window,
-                               UINT eventID,
-                               Win32Callback callback,
-                               void *boundData,
-                               Win32ReleaseFunction releaseData);
+guint win32_window_add_listener (Win32Window *window,
+                                 UINT eventID,
+                                 Win32Callback callback,
+                                 void *boundData,
+                                 Win32ReleaseFunction releaseData,
+                                 guint flags);
+BOOL  win32_window_remove_listener (Win32Window *window, guint handle);
 
 /* PROPERTIES */
 void win32_window_set_positioning (Win32Window *window, Win32LayoutData* layoutData);
@@ -103,6 +159,8 @@ char* win32_window_get_text (Win32Window *window);
 
 void  win32_window_set_enabled (Win32Window *window, BOOL isEnabled);
 BOOL  win32_window_get_enabled (Win32Window *window);
+void  win32_window_set_visible (Win32Window *window, BOOL isVisible);
+BOOL  win32_window_get_visible (Win32Window *window);
 
 void  win32_window_set_top  (Win32Window *window, int top);
 int   win32_window_get_top  (Win32Window *window);
@@ -117,23 +175,34 @@ void  win32_window_set_height (Win32Window *window, int height);
 int   win32_window_get_height (Win32Window *window);
 
 /* METHODS */
-Win32Rect* win32_window_get_window_rect(Win32Window *window);
-Win32Rect* win32_window_get_client_rect(Win32Window *window);
+BOOL win32_window_get_window_rect (Win32Window *window, RECT *rect);
+BOOL win32_window_get_client_rect (Win32Window *window, RECT *rect);
+BOOL win32_window_get_client_size (Win32Window *window, SIZE *size);
+BOOL win32_window_client_to_screen (Win32Window *window, POINT *point);
 
 void win32_window_move   (Win32Window *window, int left, int top);
 void win32_window_resize (Win32Window *window, int width, int height);
 void win32_window_move_and_resize  (Win32Window *window, int left, int top, int width, int height);
 
+void  win32_window_begin_update (Win32Window *window);
+guint win32_window_end_update   (Win32Window *window);
+
 HDC win32_window_begin_paint(Win32Window *window, PAINTSTRUCT *ps);
 void win32_window_end_paint(Win32Window *window, PAINTSTRUCT *ps);
 
 /* INTERNAL */
+void win32_window_sync_geometry (Win32Window *window);
+void win32_window_flush_geometry (Win32Window *window, HDWP *transaction);
+BOOL win32_window_is_updating (Win32Window *window);
+BOOL win32_window_update_layout (Win32Window *window);
 LRESULT win32_window_default_procedure(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
-BOOL  win32_window_insert_into_callback_queue (Win32Window *window,
+guint win32_window_insert_into_callback_queue (Win32Window *window,
                                                UINT eventID,
                                                Win32Callback callback,
                                                void *boundData,
-                                               Win32ReleaseFunction releaseData);
+                                               Win32ReleaseFunction releaseData,
+                                               guint flags);
+void  win32_window_flush_coalesced (Win32Window *window);
 
 gpointer win32_window_ref   (gpointer instance);
 void     win32_window_unref (gpointer instance);
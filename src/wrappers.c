@@ -16,24 +16,3 @@ BOOL win32_post_message(Win32Window* window, UINT msg, WPARAM wParam, LPARAM lPa
 {
     return PostMessage(window->hwnd, msg, wParam, lParam);
 }
-
-
-/* INTERNAL REF RECT
-------------------------------------------- */
-void* win32_rect_ref (void* instance)
-{
-    Win32Rect * self = instance;
-    g_atomic_int_inc (&self->ref_count);
-    return self;
-}
-
-
-/* INTERNAL UNREF RECT
-------------------------------------------- */
-void win32_rect_unref (void* instance)
-{
-    Win32Rect * self = instance;
-    if (g_atomic_int_dec_and_test (&self->ref_count)) {
-        free (self);
-    }
-}
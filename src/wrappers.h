@@ -10,19 +10,6 @@
 #include <glib-object.h>
 #include <glib.h>
 
-/* STRUCT WRAPPER RECT (REF COUNTED)
-------------------------------------------- */
-typedef struct _Win32Rect {
-    LONG left;
-    LONG top;
-    LONG right;
-    LONG bottom;
-    volatile int ref_count;
-} Win32Rect;
-
-void* win32_rect_ref   (void*);
-void  win32_rect_unref (void*);
-
 #endif
 
 